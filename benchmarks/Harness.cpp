@@ -0,0 +1,48 @@
+#include "Harness.h"
+#include "../src/PluginProcessor.h"
+#include <thread>
+
+namespace harness
+{
+	std::unique_ptr<GATE12AudioProcessor> createProcessor(double sampleRate, int blockSize)
+	{
+		auto processor = std::make_unique<GATE12AudioProcessor>();
+		processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor->prepareToPlay(sampleRate, blockSize);
+		return processor;
+	}
+
+	void callOnMessageThread(std::function<void()> fn)
+	{
+		auto* mm = juce::MessageManager::getInstanceWithoutCreating();
+		if (mm == nullptr || mm->isThisTheMessageThread()) {
+			fn();
+			return;
+		}
+
+		// no timeout, returning early would let the worker race the message thread
+		juce::WaitableEvent done;
+		juce::MessageManager::callAsync([&fn, &done]() {
+			fn();
+			done.signal();
+		});
+		done.wait(-1);
+	}
+
+	void drainMessageQueue()
+	{
+		callOnMessageThread([]() {});
+	}
+
+	int runWithMessageLoop(std::function<int()> fn)
+	{
+		int result = 0;
+		std::thread worker([&]() {
+			result = fn();
+			juce::MessageManager::getInstance()->stopDispatchLoop(); // queued if the loop has not started yet
+		});
+		juce::MessageManager::getInstance()->runDispatchLoop();
+		worker.join();
+		return result;
+	}
+}
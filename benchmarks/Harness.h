@@ -0,0 +1,39 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+
+class GATE12AudioProcessor;
+
+/**
+ * Helpers shared by the benchmark console app harnesses.
+ *
+ * Processors post change messages and async updates to the message thread, so harnesses
+ * run on a worker thread while the main thread dispatches messages, like a host would.
+ */
+namespace harness
+{
+	/**
+	 * Creates a processor prepared to play, without an editor
+	 */
+	std::unique_ptr<GATE12AudioProcessor> createProcessor(double sampleRate, int blockSize);
+
+	/**
+	 * Runs fn on the message thread and waits for it, call from the worker thread
+	 * The worker is blocked meanwhile, so fn and the worker never touch a processor at the same time
+	 */
+	void callOnMessageThread(std::function<void()> fn);
+
+	/**
+	 * Waits until the messages posted so far are delivered, call from the worker thread
+	 * before deleting processors that may have pending messages
+	 */
+	void drainMessageQueue();
+
+	/**
+	 * Runs fn on a worker thread while the calling thread dispatches messages
+	 * @return The value returned by fn, used as the process exit code
+	 */
+	int runWithMessageLoop(std::function<int()> fn);
+}
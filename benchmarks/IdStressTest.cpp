@@ -0,0 +1,107 @@
+#include "IdStressTest.h"
+#include "Harness.h"
+#include "../src/PluginProcessor.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Ids
+	{
+		std::vector<uint64_t> points;
+		std::vector<uint64_t> versions;
+
+		void collect(const Pattern& pattern)
+		{
+			for (auto& point : pattern.points)
+				points.push_back(point.id);
+			versions.push_back(pattern.versionID);
+		}
+	};
+
+	// returns the number of ids and how many of them repeat an earlier id
+	std::pair<size_t, size_t> countDuplicates(std::vector<uint64_t> all)
+	{
+		std::sort(all.begin(), all.end());
+		auto unique = std::unique(all.begin(), all.end());
+		return { all.size(), (size_t)std::distance(unique, all.end()) };
+	}
+
+	void edit(GATE12AudioProcessor& processor, int iteration, const IdStressTest::Config& config, Ids& ids)
+	{
+		auto& pattern = *processor.viewPattern;
+		pattern.loadRandom(8, processor.newPatternSeed(), processor.randomOptions);
+		pattern.doublePattern();
+		pattern.incrementVersion();
+		ids.collect(pattern);
+
+		// the clipboard is shared, the pasted points may come from an instance on another thread
+		pattern.copy(*processor.clipboard);
+		pattern.paste(*processor.clipboard);
+		ids.collect(pattern);
+
+		// the restore runs on the message thread while this worker waits, like a host restoring a project
+		// audio is not running so the restored points are swapped and versioned before it returns
+		if (config.stateInterval > 0 && iteration % config.stateInterval == config.stateInterval - 1) {
+			harness::callOnMessageThread([&processor]() {
+				juce::MemoryBlock data;
+				processor.getStateInformation(data);
+				processor.setStateInformation(data.getData(), (int)data.getSize());
+			});
+			ids.collect(*processor.viewPattern);
+		}
+	}
+}
+
+IdStressTest::Result IdStressTest::evaluate(const Config& c)
+{
+	Result result;
+	result.instances = juce::jmax(1, c.instances);
+	result.threads = juce::jlimit(1, result.instances, c.threads);
+
+	std::vector<std::unique_ptr<GATE12AudioProcessor>> processors;
+	for (int i = 0; i < result.instances; ++i) {
+		processors.push_back(harness::createProcessor(48000.0, 256));
+	}
+
+	std::vector<Ids> ids(result.threads);
+	std::vector<std::thread> workers;
+	auto start = juce::Time::getMillisecondCounterHiRes();
+	for (int t = 0; t < result.threads; ++t) {
+		workers.emplace_back([&, t]() {
+			auto first = t * result.instances / result.threads;
+			auto last = (t + 1) * result.instances / result.threads;
+			for (int i = 0; i < c.iterations; ++i) {
+				for (int p = first; p < last; ++p)
+					edit(*processors[p], i, c, ids[t]);
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	result.millis = juce::Time::getMillisecondCounterHiRes() - start;
+
+	harness::drainMessageQueue(); // state restore posts updates to each instance
+	processors.clear();
+
+	std::vector<uint64_t> points, versions;
+	for (auto& list : ids) {
+		points.insert(points.end(), list.points.begin(), list.points.end());
+		versions.insert(versions.end(), list.versions.begin(), list.versions.end());
+	}
+	std::tie(result.pointIds, result.pointDuplicates) = countDuplicates(std::move(points));
+	std::tie(result.versionIds, result.versionDuplicates) = countDuplicates(std::move(versions));
+	return result;
+}
+
+juce::String IdStressTest::toText(const Result& r)
+{
+	juce::String text;
+	text << "instances: " << r.instances << "\n"
+		<< "threads: " << r.threads << "\n"
+		<< "ms: " << juce::String(r.millis, 1) << "\n"
+		<< "point ids: " << (juce::int64)r.pointIds << ", duplicates: " << (juce::int64)r.pointDuplicates << "\n"
+		<< "version ids: " << (juce::int64)r.versionIds << ", duplicates: " << (juce::int64)r.versionDuplicates << "\n";
+	return text;
+}
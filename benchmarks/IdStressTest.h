@@ -0,0 +1,48 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * IdStressTest edits the patterns of many processors from parallel threads and checks
+ * that point and version ids never collide across instances.
+ *
+ * Each worker owns a share of the instances and repeats random generation, doubling,
+ * copy and paste through the clipboard shared by all instances and state save and restore,
+ * collecting every id produced on the way.
+ *
+ * An instance is only touched by one thread at a time: its worker, or the message thread
+ * for state restore while the worker waits, so the test races on nothing but the id counters.
+ *
+ * Run headless with the benchmark console app: GATE12Benchmarks ids
+ */
+class IdStressTest
+{
+public:
+	struct Config
+	{
+		int instances = 64;
+		int threads = 16;
+		int iterations = 500; // edit rounds per instance
+		int stateInterval = 50; // iterations between state save and restore
+	};
+
+	struct Result
+	{
+		int instances = 0;
+		int threads = 0;
+		double millis = 0.0;
+		size_t pointIds = 0;
+		size_t pointDuplicates = 0;
+		size_t versionIds = 0;
+		size_t versionDuplicates = 0;
+
+		bool passed() const { return pointDuplicates == 0 && versionDuplicates == 0; }
+	};
+
+	/**
+	 * Runs the test, blocking, from any thread but the message thread
+	 */
+	static Result evaluate(const Config& config);
+
+	static juce::String toText(const Result& result);
+};
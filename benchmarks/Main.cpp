@@ -0,0 +1,133 @@
+// Copyright 2025 tilr
+// Benchmark console app
+// Headless harnesses that drive the processor without a host or an editor,
+// built with -DBUILD_BENCHMARKS=ON, run GATE12Benchmarks --help for the commands
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "Harness.h"
+#include "SoakBenchmark.h"
+#include "IdStressTest.h"
+#include "OnsetBenchmark.h"
+#include "StateBenchmark.h"
+
+namespace
+{
+	int intOption(const juce::ArgumentList& args, const juce::String& option, int fallback)
+	{
+		return args.containsOption(option) ? args.getValueForOption(option).getIntValue() : fallback;
+	}
+
+	double doubleOption(const juce::ArgumentList& args, const juce::String& option, double fallback)
+	{
+		return args.containsOption(option) ? args.getValueForOption(option).getDoubleValue() : fallback;
+	}
+
+	// prints the report and writes it to --out when given
+	void report(const juce::ArgumentList& args, const juce::String& text)
+	{
+		std::cout << text << std::flush;
+		if (args.containsOption("--out"))
+			args.getFileForOption("--out").replaceWithText(text);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInit;
+	juce::ConsoleApplication app;
+	app.addHelpCommand("--help|-h", "GATE-12 benchmarks", true);
+
+	app.addCommand({ "soak",
+		"soak [--instances=200] [--threads=<cpus>] [--seconds=10] [--block=256] [--rate=48000] [--out=file]",
+		"Processes many instances on a pool of worker threads",
+		"Every instance processes --seconds of audio in blocks, with random parameter automation\n"
+		"and pattern switches. Reports realtime load, memory per instance, cache counters and\n"
+		"the scaling efficiency against a single worker.",
+		[](const juce::ArgumentList& args) {
+			SoakBenchmark::Config config;
+			config.instances = intOption(args, "--instances", config.instances);
+			config.threads = intOption(args, "--threads", juce::SystemStats::getNumCpus());
+			config.seconds = doubleOption(args, "--seconds", config.seconds);
+			config.blockSize = intOption(args, "--block", config.blockSize);
+			config.sampleRate = doubleOption(args, "--rate", config.sampleRate);
+			if (config.instances < 1 || config.threads < 1 || config.blockSize < 1 || config.seconds <= 0.0 || config.sampleRate <= 0.0)
+				juce::ConsoleApplication::fail("invalid soak options");
+
+			harness::runWithMessageLoop([&]() {
+				report(args, SoakBenchmark::toText(SoakBenchmark::evaluate(config)));
+				return 0;
+			});
+		}
+	});
+
+	app.addCommand({ "onset",
+		"onset <corpus folder> [--bpm=120] [--out=file.csv]",
+		"Scores the audio trigger detectors against an annotated corpus",
+		"Audio files need a label file with the same name and a .txt or .onsets extension,\n"
+		"one onset time in seconds per line. Prints one CSV row per algorithm, threshold\n"
+		"and sensitivity. --bpm sets the tempo of beat based trigger cooldowns.",
+		[](const juce::ArgumentList& args) {
+			args.checkMinNumArguments(2);
+			auto corpus = args[1].resolveAsExistingFolder();
+			auto bpm = doubleOption(args, "--bpm", 120.0);
+			if (bpm <= 0.0)
+				juce::ConsoleApplication::fail("invalid bpm");
+
+			auto scores = OnsetBenchmark::evaluate(corpus, bpm);
+			if (scores.empty())
+				juce::ConsoleApplication::fail("no labelled audio files in " + corpus.getFullPathName());
+			report(args, OnsetBenchmark::toCSV(scores));
+		}
+	});
+
+	app.addCommand({ "state",
+		"state [--runs=100] [--grid=16] [--state=file] [--out=file.csv]",
+		"Times saving and loading the plugin state in each format",
+		"Measures a state with every pattern filled with --grid random points, or the plugin\n"
+		"chunk saved in --state. Prints the size and mean save and load time of each format.",
+		[](const juce::ArgumentList& args) {
+			StateBenchmark::Config config;
+			config.runs = intOption(args, "--runs", config.runs);
+			config.grid = intOption(args, "--grid", config.grid);
+			if (args.containsOption("--state"))
+				config.stateFile = args.getExistingFileForOption("--state");
+			if (config.runs < 1 || config.grid < 1)
+				juce::ConsoleApplication::fail("invalid state options");
+
+			auto exitCode = harness::runWithMessageLoop([&]() {
+				auto scores = StateBenchmark::evaluate(config);
+				if (scores.empty())
+					return 1;
+				report(args, StateBenchmark::toCSV(scores));
+				return 0;
+			});
+			if (exitCode != 0)
+				juce::ConsoleApplication::fail("could not read " + config.stateFile.getFullPathName(), exitCode);
+		}
+	});
+
+	app.addCommand({ "ids",
+		"ids [--instances=64] [--threads=16] [--iterations=500] [--out=file]",
+		"Edits patterns of many instances in parallel and checks ids never collide",
+		"Exits with code 1 when duplicate point or version ids are found.",
+		[](const juce::ArgumentList& args) {
+			IdStressTest::Config config;
+			config.instances = intOption(args, "--instances", config.instances);
+			config.threads = intOption(args, "--threads", config.threads);
+			config.iterations = intOption(args, "--iterations", config.iterations);
+			if (config.instances < 1 || config.threads < 1 || config.iterations < 1)
+				juce::ConsoleApplication::fail("invalid ids options");
+
+			auto exitCode = harness::runWithMessageLoop([&]() {
+				auto result = IdStressTest::evaluate(config);
+				report(args, IdStressTest::toText(result));
+				return result.passed() ? 0 : 1;
+			});
+			if (exitCode != 0)
+				juce::ConsoleApplication::fail("duplicate ids found", exitCode);
+		}
+	});
+
+	return app.findAndRunCommand(argc, argv);
+}
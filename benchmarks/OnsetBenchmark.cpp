@@ -0,0 +1,165 @@
+#include "OnsetBenchmark.h"
+#include "../src/dsp/Transient.h"
+#include "../src/dsp/RetriggerPolicy.h"
+#include <cmath>
+
+std::vector<OnsetBenchmark::Score> OnsetBenchmark::evaluate(const juce::File& corpusDir, double bpm)
+{
+	std::vector<Score> scores;
+	auto items = loadCorpus(corpusDir);
+	if (items.empty())
+		return scores;
+
+	for (int algo = 0; algo < 2; ++algo) {
+		for (int t = 1; t < 10; ++t) {
+			for (int s = 1; s < 10; ++s) {
+				Score score;
+				score.algo = algo;
+				score.threshold = t / 10.0;
+				score.sense = s / 10.0;
+
+				double elapsed = 0.0;
+				int64_t totalSamples = 0;
+				double errorSum = 0.0;
+				double offsetSum = 0.0;
+
+				for (auto& item : items) {
+					double itemElapsed = 0.0;
+					auto hits = detect(item, algo, score.threshold, score.sense, bpm, itemElapsed);
+					elapsed += itemElapsed;
+					totalSamples += item.audio.getNumSamples();
+
+					// greedy one to one matching, both lists are sorted
+					double window = MATCH_WINDOW_MILLIS / 1000.0;
+					size_t h = 0;
+					int matched = 0;
+					for (auto onset : item.onsets) {
+						while (h < hits.size() && hits[h] < onset - window) {
+							score.falsePositives += 1;
+							++h;
+						}
+						if (h < hits.size() && hits[h] <= onset + window) {
+							errorSum += std::fabs(hits[h] - onset);
+							offsetSum += hits[h] - onset;
+							matched += 1;
+							++h;
+						}
+						else {
+							score.falseNegatives += 1;
+						}
+					}
+					score.falsePositives += (int)(hits.size() - h);
+					score.truePositives += matched;
+				}
+
+				auto tp = (double)score.truePositives;
+				score.precision = tp + score.falsePositives > 0 ? tp / (tp + score.falsePositives) : 0.0;
+				score.recall = tp + score.falseNegatives > 0 ? tp / (tp + score.falseNegatives) : 0.0;
+				score.fmeasure = score.precision + score.recall > 0.0
+					? 2.0 * score.precision * score.recall / (score.precision + score.recall)
+					: 0.0;
+				score.meanErrorMillis = tp > 0 ? errorSum / tp * 1000.0 : 0.0;
+				score.meanOffsetMillis = tp > 0 ? offsetSum / tp * 1000.0 : 0.0;
+				score.nsPerSample = totalSamples > 0 ? elapsed * 1e9 / (double)totalSamples : 0.0;
+				scores.push_back(score);
+			}
+		}
+	}
+
+	return scores;
+}
+
+juce::String OnsetBenchmark::toCSV(const std::vector<Score>& scores)
+{
+	juce::String csv = "algo,threshold,sense,tp,fp,fn,precision,recall,fmeasure,mean_error_ms,mean_offset_ms,ns_per_sample\n";
+	for (auto& s : scores) {
+		csv << (s.algo == 0 ? "simple" : "drums") << ","
+			<< s.threshold << "," << s.sense << ","
+			<< s.truePositives << "," << s.falsePositives << "," << s.falseNegatives << ","
+			<< juce::String(s.precision, 4) << "," << juce::String(s.recall, 4) << "," << juce::String(s.fmeasure, 4) << ","
+			<< juce::String(s.meanErrorMillis, 3) << "," << juce::String(s.meanOffsetMillis, 3) << ","
+			<< juce::String(s.nsPerSample, 2) << "\n";
+	}
+	return csv;
+}
+
+std::vector<OnsetBenchmark::CorpusItem> OnsetBenchmark::loadCorpus(const juce::File& corpusDir)
+{
+	std::vector<CorpusItem> items;
+	juce::AudioFormatManager formats;
+	formats.registerBasicFormats();
+
+	auto files = corpusDir.findChildFiles(juce::File::findFiles, false, formats.getWildcardForAllFormats());
+	files.sort();
+	for (auto& file : files) {
+		auto labels = file.withFileExtension(".txt");
+		if (!labels.existsAsFile())
+			labels = file.withFileExtension(".onsets");
+		if (!labels.existsAsFile())
+			continue;
+
+		std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+		if (reader == nullptr || reader->lengthInSamples <= 0)
+			continue;
+
+		CorpusItem item;
+		item.name = file.getFileName();
+		item.srate = reader->sampleRate;
+		item.audio.setSize(2, (int)reader->lengthInSamples);
+		reader->read(&item.audio, 0, (int)reader->lengthInSamples, 0, true, true);
+		item.onsets = loadLabels(labels);
+		items.push_back(std::move(item));
+	}
+
+	return items;
+}
+
+std::vector<double> OnsetBenchmark::loadLabels(const juce::File& file)
+{
+	std::vector<double> onsets;
+	juce::StringArray lines;
+	file.readLines(lines);
+	for (auto& line : lines) {
+		auto token = line.trim().upToFirstOccurrenceOf("\t", false, false).upToFirstOccurrenceOf(" ", false, false);
+		if (token.isEmpty() || !juce::CharacterFunctions::isDigit(token[0]))
+			continue;
+		onsets.push_back(token.getDoubleValue());
+	}
+	std::sort(onsets.begin(), onsets.end());
+	return onsets;
+}
+
+/*
+	Mirrors the audio trigger path of processBlock
+	using the default filter settings (no low or high cut)
+*/
+std::vector<double> OnsetBenchmark::detect(const CorpusItem& item, int algo, double threshold, double sense, double bpm, double& elapsedSeconds)
+{
+	std::vector<double> hits;
+	Transient detectorL;
+	Transient detectorR;
+	RetriggerPolicy policy{ globals::AUDIO_COOLDOWN_MILLIS };
+	detectorL.clear(item.srate);
+	detectorR.clear(item.srate);
+	sense = std::pow(1.0 - sense, 2);
+
+	auto left = item.audio.getReadPointer(0);
+	auto right = item.audio.getReadPointer(item.audio.getNumChannels() > 1 ? 1 : 0);
+	auto numSamples = item.audio.getNumSamples();
+	auto samplesPerBeat = 60.0 / bpm * item.srate;
+
+	auto start = juce::Time::getHighResolutionTicks();
+	for (int i = 0; i < numSamples; ++i) {
+		// both detectors see every sample, like processBlock, their envelopes depend on it
+		bool detected = detectorL.detect(algo, left[i], threshold, sense);
+		detected = detectorR.detect(algo, right[i], threshold, sense) || detected;
+		if (detected)
+		{
+			if (policy.passCooldown(i, item.srate, samplesPerBeat))
+				hits.push_back(i / item.srate);
+		}
+	}
+	elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+	return hits;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <memory>
+
+/**
+ * OnsetBenchmark runs the audio trigger detectors offline over an annotated
+ * corpus and reports accuracy and CPU cost for a grid of settings.
+ *
+ * The corpus is a folder of audio files, each with a label file next to it
+ * sharing the same name and a .txt or .onsets extension. Label files contain
+ * one onset time in seconds per line, extra columns (eg. Audacity labels) are ignored.
+ *
+ * Run headless with the benchmark console app: GATE12Benchmarks onset <corpus folder>
+ */
+class OnsetBenchmark
+{
+public:
+	struct Score
+	{
+		int algo = 0;
+		double threshold = 0.0;
+		double sense = 0.0;
+		int truePositives = 0;
+		int falsePositives = 0;
+		int falseNegatives = 0;
+		double precision = 0.0;
+		double recall = 0.0;
+		double fmeasure = 0.0;
+		double meanErrorMillis = 0.0; // mean absolute error of matched onsets
+		double meanOffsetMillis = 0.0; // mean signed error, positive when detections are late
+		double nsPerSample = 0.0;
+	};
+
+	/**
+	 * Runs every grid point over the corpus, blocking
+	 * @param corpusDir Folder with audio and label files
+	 * @param bpm Tempo used to evaluate beat based trigger cooldowns
+	 * @return One score per algorithm, threshold and sensitivity combination
+	 */
+	static std::vector<Score> evaluate(const juce::File& corpusDir, double bpm = 120.0);
+
+	static juce::String toCSV(const std::vector<Score>& scores);
+
+private:
+	struct CorpusItem
+	{
+		juce::String name;
+		juce::AudioBuffer<float> audio;
+		double srate = 44100.0;
+		std::vector<double> onsets; // seconds
+	};
+
+	static constexpr double MATCH_WINDOW_MILLIS = 50.0; // onset tolerance window (MIREX uses +-50ms)
+	static std::vector<CorpusItem> loadCorpus(const juce::File& corpusDir);
+	static std::vector<double> loadLabels(const juce::File& file);
+	static std::vector<double> detect(const CorpusItem& item, int algo, double threshold, double sense, double bpm, double& elapsedSeconds);
+};
@@ -0,0 +1,267 @@
+#include "SoakBenchmark.h"
+#include "Harness.h"
+#include "../src/PluginProcessor.h"
+#include "../src/utils/PatternLibrary.h"
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#if JUCE_LINUX || JUCE_MAC
+#include <sys/resource.h>
+#endif
+#if JUCE_LINUX
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// process-wide mutexes shared by all instances
+	std::vector<std::pair<juce::String, const LockCounters*>> sharedLocks()
+	{
+		return {
+			{ "PaintPatternStore", &PaintPatternStore::getLockCounters() },
+			{ "PatternClipboard", &PatternClipboard::getLockCounters() },
+			{ "SettingsStore", &SettingsStore::getLockCounters() },
+			{ "PatternLibrary", &PatternLibrary::getLockCounters() },
+		};
+	}
+}
+
+struct SoakBenchmark::Instance : public juce::AudioPlayHead
+{
+	std::unique_ptr<GATE12AudioProcessor> processor;
+	juce::AudioBuffer<float> buffer;
+	juce::MidiBuffer midi;
+	juce::Random random;
+	const juce::AudioBuffer<float>* noise = nullptr; // shared input signal
+	int noisePos = 0;
+	double ppq = 0.0;
+
+	juce::Optional<PositionInfo> getPosition() const override
+	{
+		PositionInfo info;
+		info.setIsPlaying(true);
+		info.setBpm(120.0);
+		info.setPpqPosition(ppq);
+		return info;
+	}
+};
+
+namespace
+{
+	double processCpuSeconds()
+	{
+#if JUCE_LINUX || JUCE_MAC
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return -1.0;
+		return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#else
+		return -1.0;
+#endif
+	}
+
+	juce::int64 residentBytes()
+	{
+#if JUCE_LINUX
+		std::ifstream statm("/proc/self/statm");
+		long size = 0, resident = 0;
+		if (statm >> size >> resident)
+			return (juce::int64)resident * sysconf(_SC_PAGESIZE);
+#endif
+		return -1;
+	}
+
+	enum class Counter { CacheReferences, CacheMisses };
+
+	// counts this process and the threads created after it is opened, -1 when perf events are not permitted
+	int openCounter(Counter counter)
+	{
+#if JUCE_LINUX
+		perf_event_attr attr{};
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = counter == Counter::CacheMisses ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_CACHE_REFERENCES;
+		attr.inherit = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+		juce::ignoreUnused(counter);
+		return -1;
+#endif
+	}
+
+	// inherited counts are added when the threads exit, read after the worker pool is destroyed
+	juce::int64 readCounter(int fd)
+	{
+#if JUCE_LINUX
+		if (fd < 0)
+			return -1;
+		juce::uint64 value = 0;
+		auto bytes = read(fd, &value, sizeof(value));
+		close(fd);
+		return bytes == (ssize_t)sizeof(value) ? (juce::int64)value : -1;
+#else
+		juce::ignoreUnused(fd);
+		return -1;
+#endif
+	}
+}
+
+SoakBenchmark::Result SoakBenchmark::evaluate(const Config& c)
+{
+	Result result;
+	result.instances = juce::jmax(1, c.instances);
+	result.threads = juce::jlimit(1, result.instances, c.threads);
+	const int blocks = juce::jmax(1, (int)std::ceil(c.seconds * c.sampleRate / c.blockSize));
+
+	juce::Random random(c.seed);
+	juce::AudioBuffer<float> noise(2, (int)c.sampleRate);
+	for (int ch = 0; ch < noise.getNumChannels(); ++ch) {
+		auto data = noise.getWritePointer(ch);
+		for (int i = 0; i < noise.getNumSamples(); ++i)
+			data[i] = random.nextFloat() * 0.5f - 0.25f;
+	}
+
+	auto rssBefore = residentBytes();
+	std::vector<std::unique_ptr<Instance>> instances;
+	for (int i = 0; i < result.instances; ++i) {
+		auto instance = std::make_unique<Instance>();
+		instance->processor = harness::createProcessor(c.sampleRate, c.blockSize);
+		auto& processor = *instance->processor;
+		processor.setPlayHead(instance.get());
+		instance->buffer.setSize(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()), c.blockSize);
+		instance->random.setSeed(c.seed + i);
+		instance->noise = &noise;
+		instance->noisePos = instance->random.nextInt(noise.getNumSamples() - c.blockSize);
+		instances.push_back(std::move(instance));
+	}
+
+	// single thread baseline, also warms up buffers allocated on the first blocks
+	auto baseline = drive(instances, 1, juce::jmax(1, blocks / 10), c);
+	auto rssAfter = residentBytes();
+	if (rssBefore >= 0 && rssAfter >= 0)
+		result.rssPerInstanceKB = (rssAfter - rssBefore) / 1024.0 / result.instances;
+
+	int cacheReferences = openCounter(Counter::CacheReferences);
+	int cacheMisses = openCounter(Counter::CacheMisses);
+	std::vector<LockCounters::Snapshot> locksBefore;
+	for (auto& lock : sharedLocks())
+		locksBefore.push_back(lock.second->snapshot());
+	auto cpuBefore = processCpuSeconds();
+	auto phase = drive(instances, result.threads, blocks, c);
+	auto cpuAfter = processCpuSeconds();
+	result.cacheReferences = readCounter(cacheReferences);
+	result.cacheMisses = readCounter(cacheMisses);
+	auto locks = sharedLocks();
+	for (size_t i = 0; i < locks.size(); ++i) {
+		auto after = locks[i].second->snapshot();
+		result.lockWaits.push_back({ locks[i].first, (juce::int64)(after.contended - locksBefore[i].contended), after.waitMillis - locksBefore[i].waitMillis });
+	}
+
+	harness::drainMessageQueue(); // processBlock posts change messages to its own instance
+	instances.clear();
+
+	auto blockSeconds = c.blockSize / c.sampleRate;
+	result.audioSeconds = (double)phase.blocks / result.instances * blockSeconds;
+	result.wallSeconds = phase.wallSeconds;
+	result.cpuSeconds = cpuBefore >= 0.0 && cpuAfter >= 0.0 ? cpuAfter - cpuBefore : -1.0;
+	result.realtimeLoad = result.audioSeconds > 0.0 ? result.wallSeconds / result.audioSeconds : 0.0;
+	result.maxBlockMillis = juce::jmax(baseline.maxBlockMillis, phase.maxBlockMillis);
+
+	auto throughput = phase.wallSeconds > 0.0 ? phase.blocks / phase.wallSeconds : 0.0;
+	auto baseThroughput = baseline.wallSeconds > 0.0 ? baseline.blocks / baseline.wallSeconds : 0.0;
+	result.scalingEfficiency = baseThroughput > 0.0 ? throughput / baseThroughput / result.threads : 0.0;
+	return result;
+}
+
+// every cycle is one host audio callback, instances are split in one chunk per worker
+// and the next cycle starts when every worker is done
+SoakBenchmark::Phase SoakBenchmark::drive(std::vector<std::unique_ptr<Instance>>& instances, int threads, int blocks, const Config& c)
+{
+	Phase phase;
+	const int count = (int)instances.size();
+	std::vector<double> maxMillis(threads, 0.0);
+	std::atomic<int> remaining = 0;
+	juce::WaitableEvent cycleDone;
+
+	{
+		juce::ThreadPool pool(threads);
+		auto start = juce::Time::getMillisecondCounterHiRes();
+		for (int b = 0; b < blocks; ++b) {
+			remaining.store(threads);
+			for (int t = 0; t < threads; ++t) {
+				pool.addJob([&, t]() {
+					for (int i = t * count / threads; i < (t + 1) * count / threads; ++i) {
+						auto blockStart = juce::Time::getHighResolutionTicks();
+						processBlock(*instances[i], c);
+						auto millis = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStart) * 1000.0;
+						maxMillis[t] = juce::jmax(maxMillis[t], millis);
+					}
+					if (remaining.fetch_sub(1) == 1)
+						cycleDone.signal();
+				});
+			}
+			cycleDone.wait();
+			phase.blocks += count;
+		}
+		phase.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+	}
+
+	for (auto millis : maxMillis)
+		phase.maxBlockMillis = juce::jmax(phase.maxBlockMillis, millis);
+	return phase;
+}
+
+void SoakBenchmark::processBlock(Instance& instance, const Config& c)
+{
+	auto& processor = *instance.processor;
+	auto& random = instance.random;
+
+	// parameter changes notify listeners like host automation does
+	auto automate = [](juce::AudioProcessorParameter* param, float value) {
+		param->setValue(value);
+		param->sendValueChangedMessageToListeners(value);
+	};
+	if (random.nextDouble() < c.automationRate) {
+		auto& params = processor.getParameters();
+		automate(params[random.nextInt(params.size())], random.nextFloat());
+	}
+	if (random.nextDouble() < c.patternRate) {
+		automate(processor.params.getParameter("pattern"), random.nextFloat());
+	}
+
+	auto& noise = *instance.noise;
+	if (instance.noisePos + c.blockSize > noise.getNumSamples())
+		instance.noisePos = 0;
+	for (int ch = 0; ch < instance.buffer.getNumChannels(); ++ch) {
+		instance.buffer.copyFrom(ch, 0, noise, ch % noise.getNumChannels(), instance.noisePos, c.blockSize);
+	}
+	instance.noisePos += c.blockSize;
+
+	instance.midi.clear();
+	processor.processBlock(instance.buffer, instance.midi);
+	instance.ppq += c.blockSize / c.sampleRate * 2.0; // 120 bpm
+}
+
+juce::String SoakBenchmark::toText(const Result& r)
+{
+	auto counter = [](juce::int64 value) { return value < 0 ? juce::String("unavailable") : juce::String(value); };
+	juce::String text;
+	text << "instances: " << r.instances << "\n"
+		<< "threads: " << r.threads << "\n"
+		<< "audio seconds per instance: " << juce::String(r.audioSeconds, 2) << "\n"
+		<< "wall seconds: " << juce::String(r.wallSeconds, 2) << "\n"
+		<< "cpu seconds: " << (r.cpuSeconds < 0.0 ? juce::String("unavailable") : juce::String(r.cpuSeconds, 2)) << "\n"
+		<< "realtime load: " << juce::String(r.realtimeLoad * 100.0, 1) << "%\n"
+		<< "max block ms: " << juce::String(r.maxBlockMillis, 3) << "\n"
+		<< "rss per instance KB: " << (r.rssPerInstanceKB < 0.0 ? juce::String("unavailable") : juce::String(r.rssPerInstanceKB, 1)) << "\n"
+		<< "cache references: " << counter(r.cacheReferences) << "\n"
+		<< "cache misses: " << counter(r.cacheMisses) << "\n";
+	for (auto& lock : r.lockWaits)
+		text << lock.name << " lock waits: " << lock.contended << ", " << juce::String(lock.waitMillis, 3) << " ms\n";
+	text << "scaling efficiency: " << juce::String(r.scalingEfficiency * 100.0, 1) << "%\n";
+	return text;
+}
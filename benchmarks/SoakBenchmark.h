@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <memory>
+
+/**
+ * SoakBenchmark creates many processors in one process and drives their processBlock
+ * calls from a pool of worker threads, the way a host runs hundreds of instances.
+ * Blocks get random parameter automation and pattern switches through the parameters,
+ * the same path used by host automation.
+ *
+ * The report has aggregate CPU time and realtime load, resident memory per instance,
+ * hardware cache counters when perf events are permitted (Linux), lock waits on the mutexes
+ * shared by all instances and the scaling efficiency against a single worker,
+ * a low efficiency points at contention on shared state.
+ *
+ * Run headless with the benchmark console app: GATE12Benchmarks soak
+ */
+class SoakBenchmark
+{
+public:
+	struct Config
+	{
+		int instances = 200;
+		int threads = 4;
+		int blockSize = 256;
+		double sampleRate = 48000.0;
+		double seconds = 10.0; // audio seconds processed by every instance
+		double automationRate = 0.05; // probability of a parameter change per block
+		double patternRate = 0.01; // probability of a pattern switch per block
+		juce::int64 seed = 1;
+	};
+
+	struct LockWait
+	{
+		juce::String name;
+		juce::int64 contended = 0; // lock calls that found the mutex taken
+		double waitMillis = 0.0; // time spent waiting by those calls
+	};
+
+	struct Result
+	{
+		int instances = 0;
+		int threads = 0;
+		double audioSeconds = 0.0; // audio processed by each instance
+		double wallSeconds = 0.0;
+		double cpuSeconds = -1.0; // process CPU time, -1 when unavailable
+		double realtimeLoad = 0.0; // wall time over audio time, above 1 the host would drop out
+		double maxBlockMillis = 0.0; // slowest block of any instance
+		double rssPerInstanceKB = -1.0; // resident memory growth per instance, -1 when unavailable
+		juce::int64 cacheReferences = -1; // -1 when perf events are unavailable
+		juce::int64 cacheMisses = -1;
+		std::vector<LockWait> lockWaits; // measured over the same phase as the cache counters
+		double scalingEfficiency = 0.0; // throughput over threads times the single thread throughput
+	};
+
+	/**
+	 * Runs the benchmark, blocking, from any thread but the message thread
+	 */
+	static Result evaluate(const Config& config);
+
+	static juce::String toText(const Result& result);
+
+private:
+	struct Instance;
+	struct Phase
+	{
+		double wallSeconds = 0.0;
+		juce::int64 blocks = 0;
+		double maxBlockMillis = 0.0;
+	};
+
+	static Phase drive(std::vector<std::unique_ptr<Instance>>& instances, int threads, int blocks, const Config& config);
+	static void processBlock(Instance& instance, const Config& config);
+};
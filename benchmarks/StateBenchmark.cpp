@@ -0,0 +1,73 @@
+#include "StateBenchmark.h"
+#include "Harness.h"
+#include "../src/PluginProcessor.h"
+#include "../src/utils/StateCodec.h"
+#include <functional>
+
+std::vector<StateBenchmark::Score> StateBenchmark::evaluate(const Config& c)
+{
+	std::vector<Score> scores;
+	auto processor = harness::createProcessor(48000.0, 256);
+	auto runs = juce::jmax(1, c.runs);
+
+	if (c.stateFile != juce::File()) {
+		juce::MemoryBlock data;
+		if (!c.stateFile.loadFileAsData(data) || data.getSize() == 0)
+			return scores;
+		processor->setStateInformation(data.getData(), (int)data.getSize());
+	}
+	else {
+		// every pattern filled, the size of a state edited by hand
+		for (int i = 0; i < 12; ++i) {
+			processor->setViewPattern(i);
+			processor->viewPattern->loadRandom(c.grid, processor->newPatternSeed(), processor->randomOptions);
+			processor->viewPattern->buildSegments();
+		}
+		processor->setViewPattern(0);
+	}
+	harness::drainMessageQueue();
+
+	auto measure = [&](const juce::String& format, std::function<void(juce::MemoryBlock&)> save) {
+		Score score;
+		score.format = format;
+		juce::MemoryBlock data;
+		auto start = juce::Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < runs; ++i) save(data);
+		score.saveMillis = (juce::Time::getMillisecondCounterHiRes() - start) / runs;
+		score.bytes = data.getSize();
+
+		// audio is not running, restored patterns are applied on the message thread
+		// the timing covers decoding and publishing, the queued sets are applied by the drain below
+		start = juce::Time::getMillisecondCounterHiRes();
+		for (int i = 0; i < runs; ++i) processor->setStateInformation(data.getData(), (int)data.getSize());
+		score.loadMillis = (juce::Time::getMillisecondCounterHiRes() - start) / runs;
+
+		harness::drainMessageQueue();
+		scores.push_back(score);
+	};
+
+	measure("xml", [&](juce::MemoryBlock& data) {
+		std::unique_ptr<juce::XmlElement> xml(processor->createState(true).createXml());
+		data.reset();
+		juce::AudioProcessor::copyXmlToBinary(*xml, data);
+	});
+	measure("binary", [&](juce::MemoryBlock& data) {
+		StateCodec::write(processor->createState(), data);
+	});
+	measure("binary gzip", [&](juce::MemoryBlock& data) {
+		StateCodec::write(processor->createState(), data, true);
+	});
+
+	harness::drainMessageQueue();
+	return scores;
+}
+
+juce::String StateBenchmark::toCSV(const std::vector<Score>& scores)
+{
+	juce::String csv = "format, bytes, save ms, load ms\n";
+	for (auto& s : scores) {
+		csv << s.format << ", " << (juce::int64)s.bytes << ", "
+			<< juce::String(s.saveMillis, 3) << ", " << juce::String(s.loadMillis, 3) << "\n";
+	}
+	return csv;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * StateBenchmark saves and loads the plugin state repeatedly in each state format,
+ * the legacy XML with text patterns, binary and gzip compressed binary,
+ * and reports the chunk size and the mean save and load times.
+ *
+ * Loads go through setStateInformation, the path used by hosts on project load.
+ *
+ * Run headless with the benchmark console app: GATE12Benchmarks state
+ */
+class StateBenchmark
+{
+public:
+	struct Config
+	{
+		int runs = 100; // saves and loads per format
+		int grid = 16; // random points per pattern when no state file is given
+		juce::File stateFile; // a saved plugin chunk to measure instead of random patterns
+	};
+
+	struct Score
+	{
+		juce::String format;
+		size_t bytes = 0;
+		double saveMillis = 0.0;
+		double loadMillis = 0.0;
+	};
+
+	/**
+	 * Runs the benchmark, blocking, from any thread but the message thread
+	 * @return One score per format, empty if the state file could not be read
+	 */
+	static std::vector<Score> evaluate(const Config& config);
+
+	static juce::String toCSV(const std::vector<Score>& scores);
+};
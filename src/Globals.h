@@ -24,10 +24,14 @@ namespace globals {
 	constexpr int ANTICLICK_LOW_MILLIS = 5;
 	constexpr int ANTICLICK_HIGH_MILLIS = 10;
 	constexpr int AUDIO_LATENCY_MILLIS = 5;
-	constexpr int AUDIO_COOLDOWN_MILLIS = 50;
+	constexpr int AUDIO_COOLDOWN_MILLIS = 50; // default audio trigger cooldown
+	constexpr int RETRIGGER_XFADE_MILLIS = 30; // crossfade length of crossfade retrigger mode
 	constexpr int AUDIO_DRUMSBUF_MILLIS = 20;
 	constexpr int AUDIO_NOTE_LENGTH_MILLIS = 100;
+	constexpr int MIDI_OUT_CAPACITY = 128; // max pending midi out messages
+	constexpr int DISPLAY_RING_CAPACITY = 4096; // max display columns pending to be drawn by the UI
 	constexpr int MAX_UNDO = 100;
+	constexpr size_t UNDO_BUDGET_BYTES = 8 * 1024 * 1024; // max memory used by the undo history of one plugin instance
 	constexpr int BANDS_FFT_ORDER = 12;
 
 	// view consts
@@ -8,7 +8,7 @@ GATE12AudioProcessorEditor::GATE12AudioProcessorEditor (GATE12AudioProcessor& p)
     : AudioProcessorEditor (&p)
     , audioProcessor (p)
 {
-    audioProcessor.loadSettings(); // load saved paint patterns from other plugin instances
+    audioProcessor.loadSettings(true); // load saved paint patterns from other plugin instances
     setResizable(true, false);
     setResizeLimits(PLUG_WIDTH, PLUG_HEIGHT, MAX_PLUG_WIDTH, MAX_PLUG_HEIGHT);
     setSize (audioProcessor.plugWidth, audioProcessor.plugHeight);
@@ -130,6 +130,7 @@ GATE12AudioProcessorEditor::GATE12AudioProcessorEditor (GATE12AudioProcessor& p)
         };
     settingsButton->toggleUIComponents = [this]() { toggleUIComponents(); };
     settingsButton->toggleAbout = [this]() { about.get()->setVisible(true); };
+    settingsButton->toggleLibrary = [this]() { openLibrary(); };
     settingsButton->setBounds(col-15,row,25,25);
 
     col -= 25;
@@ -524,6 +525,11 @@ GATE12AudioProcessorEditor::GATE12AudioProcessorEditor (GATE12AudioProcessor& p)
     customLookAndFeel = new CustomLookAndFeel();
     setLookAndFeel(customLookAndFeel);
 
+    frameScheduler.addClient(view.get());
+    frameScheduler.addClient(audioDisplay.get());
+    frameScheduler.addClient(paintWidget.get());
+    frameScheduler.addClient(bandsWidget.get(), 30);
+
     init = true;
     resized();
     toggleUIComponents();
@@ -742,12 +748,12 @@ void GATE12AudioProcessorEditor::paint (Graphics& g)
 
     // draw undo redo buttons
     auto canUndo = audioProcessor.uimode == UIMode::Seq
-        ? !audioProcessor.sequencer->undoStack.empty()
-        : !audioProcessor.viewPattern->undoStack.empty();
+        ? audioProcessor.sequencer->history.canUndo()
+        : audioProcessor.viewPattern->history.canUndo();
 
     auto canRedo = audioProcessor.uimode == UIMode::Seq
-        ? !audioProcessor.sequencer->redoStack.empty()
-        : !audioProcessor.viewPattern->redoStack.empty();
+        ? audioProcessor.sequencer->history.canRedo()
+        : audioProcessor.viewPattern->history.canRedo();
 
     drawUndoButton(g, undoButton.getBounds().toFloat(), true, Colour(canUndo ? COLOR_ACTIVE : COLOR_NEUTRAL));
     drawUndoButton(g, redoButton.getBounds().toFloat(), false, Colour(canRedo ? COLOR_ACTIVE : COLOR_NEUTRAL));
@@ -841,11 +847,23 @@ void GATE12AudioProcessorEditor::drawUndoButton(Graphics& g, juce::Rectangle<flo
         g.strokePath(arrowPath, PathStrokeType(thickness));
 }
 
+void GATE12AudioProcessorEditor::openLibrary()
+{
+    if (!libraryBrowser) {
+        libraryBrowser = std::make_unique<LibraryBrowser>(audioProcessor);
+        addChildComponent(*libraryBrowser);
+        libraryBrowser->setBounds(getLocalBounds());
+    }
+    libraryBrowser->open();
+}
+
 void GATE12AudioProcessorEditor::resized()
 {
     if (!init) return; // defer resized() call during constructor
 
     about->setBounds(0,0,getWidth(), getHeight());
+    if (libraryBrowser)
+        libraryBrowser->setBounds(0,0,getWidth(), getHeight());
 
     // layout right aligned components and view
     // first row
@@ -15,12 +15,14 @@
 #include "ui/GridSelector.h"
 #include "ui/CustomLookAndFeel.h"
 #include "ui/About.h"
+#include "ui/LibraryBrowser.h"
 #include "ui/View.h"
 #include "ui/SettingsButton.h"
 #include "ui/AudioDisplay.h"
 #include "ui/PaintToolWidget.h"
 #include "ui/SequencerWidget.h"
 #include "ui/BandsWidget.h"
+#include "ui/FrameScheduler.h"
 
 using namespace globals;
 
@@ -44,6 +46,8 @@ private:
     bool init = false;
     CustomLookAndFeel* customLookAndFeel = nullptr;
     std::unique_ptr<About> about;
+    std::unique_ptr<LibraryBrowser> libraryBrowser; // created when first opened, its thumbnails run a thread
+    void openLibrary();
 
     std::vector<std::unique_ptr<TextButton>> patterns;
 
@@ -109,6 +113,7 @@ private:
     std::unique_ptr<SequencerWidget> seqWidget;
 
     TooltipWindow tooltipWindow;
+    FrameScheduler frameScheduler{ *this }; // declared last, destroyed before its clients
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GATE12AudioProcessorEditor)
 };
@@ -2,7 +2,6 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include <ctime>
 
 GATE12AudioProcessor::GATE12AudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -11,7 +10,6 @@ GATE12AudioProcessor::GATE12AudioProcessor()
         .withInput("Sidechain", juce::AudioChannelSet::stereo(), true)
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)
     )
-    , settings{}
     , params(*this, &undoManager, "PARAMETERS", {
         std::make_unique<juce::AudioParameterFloat>("mix", "Mix", 0.0f, 1.0f, 1.0f),
         std::make_unique<juce::AudioParameterInt>("pattern", "Pattern", 1, 12, 1),
@@ -45,17 +43,6 @@ GATE12AudioProcessor::GATE12AudioProcessor()
     })
 #endif
 {
-    srand(static_cast<unsigned int>(time(nullptr))); // seed random generator
-    juce::PropertiesFile::Options options{};
-    options.applicationName = ProjectInfo::projectName;
-    options.filenameSuffix = ".settings";
-#if defined(JUCE_LINUX) || defined(JUCE_BSD)
-    options.folderName = "~/.config/gate12";
-#endif
-    options.osxLibrarySubFolder = "Application Support";
-    options.storageFormat = PropertiesFile::storeAsXML;
-    settings.setStorageParameters(options);
-
     for (auto* param : getParameters()) {
         param->addListener(this);
     }
@@ -65,35 +52,17 @@ GATE12AudioProcessor::GATE12AudioProcessor()
     // init patterns
     for (int i = 0; i < 12; ++i) {
         patterns[i] = new Pattern(i);
+        patterns[i]->history.setBudget(undoBudget);
         patterns[i]->insertPoint(0, 1, 0, 1);
         patterns[i]->insertPoint(0.5, 0, 0, 1);
         patterns[i]->insertPoint(1, 1, 0, 1);
         patterns[i]->buildSegments();
     }
 
-    // init paintMode Patterns
-    for (int i = 0; i < PAINT_PATS; ++i) {
-        paintPatterns[i] = new Pattern(i + PAINT_PATS_IDX);
-        if (i < 8) {
-            auto preset = Presets::getPaintPreset(i);
-            for (auto& point : preset) {
-                paintPatterns[i]->insertPoint(point.x, point.y, point.tension, point.type);
-            }
-        }
-        else {
-            paintPatterns[i]->insertPoint(0.0, 1.0, 0.0, 1);
-            paintPatterns[i]->insertPoint(1.0, 0.0, 0.0, 1);
-        }
-        paintPatterns[i]->buildSegments();
-    }
-
     sequencer = new Sequencer(*this);
+    sequencer->history.setBudget(undoBudget);
     pattern = patterns[0];
     viewPattern = pattern;
-    preSamples.resize(MAX_PLUG_WIDTH, 0); // samples array size must be >= viewport width
-    postSamples.resize(MAX_PLUG_WIDTH, 0);
-    sideSamples.resize(MAX_PLUG_WIDTH, 0);
-    monSamples.resize(MAX_PLUG_WIDTH, 0); // samples array size must be >= audio monitor width
     value = new RCSmoother();
     value2 = new RCSmoother();
 
@@ -102,7 +71,12 @@ GATE12AudioProcessor::GATE12AudioProcessor()
 
 GATE12AudioProcessor::~GATE12AudioProcessor()
 {
+    cancelPendingUpdate();
     params.removeParameterListener("pattern", this);
+    delete pendingPatterns.exchange(nullptr);
+    delete adoptedPatterns.exchange(nullptr);
+    for (auto* paintPattern : paintPatterns)
+        delete paintPattern;
 }
 
 void GATE12AudioProcessor::parameterChanged (const juce::String& parameterID, float newValue)
@@ -128,52 +102,39 @@ void GATE12AudioProcessor::parameterGestureChanged (int parameterIndex, bool ges
     (void)gestureIsStarting;
 }
 
-void GATE12AudioProcessor::loadSettings ()
+// reads the settings cached by the shared store, checkFile picks up files written by other processes
+void GATE12AudioProcessor::loadSettings (bool checkFile)
 {
-    settings.closeFiles(); // FIX files changed by other plugin instances not loading
-    if (auto* file = settings.getUserSettings()) {
-        scale = (float)file->getDoubleValue("scale", 1.0f);
-        plugWidth = file->getIntValue("width", PLUG_WIDTH);
-        plugHeight = file->getIntValue("height", PLUG_HEIGHT);
-        auto tensionparam = (double)params.getRawParameterValue("tension")->load();
-        auto tensionatk = (double)params.getRawParameterValue("tensionatk")->load();
-        auto tensionrel = (double)params.getRawParameterValue("tensionrel")->load();
-
-        for (int i = 0; i < PAINT_PATS; ++i) {
-            auto str = file->getValue("paintpat" + String(i),"").toStdString();
-            if (!str.empty()) {
-                paintPatterns[i]->clear();
-                paintPatterns[i]->clearUndo();
-                double x, y, tension;
-                int type;
-                std::istringstream iss(str);
-                while (iss >> x >> y >> tension >> type) {
-                    paintPatterns[i]->insertPoint(x,y,tension,type);
-                }
-                paintPatterns[i]->setTension(tensionparam, tensionatk, tensionrel, dualTension);
-                paintPatterns[i]->buildSegments();
-            }
+    if (checkFile)
+        settingsStore->reloadIfChanged();
+
+    auto& file = settingsStore->getFile();
+    scale = (float)file.getDoubleValue("scale", 1.0f);
+    plugWidth = file.getIntValue("width", PLUG_WIDTH);
+    plugHeight = file.getIntValue("height", PLUG_HEIGHT);
+    paintStore->load(file);
+    for (int i = 0; i < PAINT_PATS; ++i) {
+        if (paintPatterns[i] != nullptr && paintSources[i] != paintStore->get(i)) {
+            resetPaintPattern(i);
         }
     }
 }
 
+// updates the cached settings, the file is written later in the background
 void GATE12AudioProcessor::saveSettings ()
 {
-    settings.closeFiles(); // FIX files changed by other plugin instances not loading
-    if (auto* file = settings.getUserSettings()) {
-        file->setValue("scale", scale);
-        file->setValue("width", plugWidth);
-        file->setValue("height", plugHeight);
-        for (int i = 0; i < PAINT_PATS; ++i) {
-            std::ostringstream oss;
-            auto points = paintPatterns[i]->points;
-            for (const auto& point : points) {
-                oss << point.x << " " << point.y << " " << point.tension << " " << point.type << " ";
-            }
-            file->setValue("paintpat"+juce::String(i), var(oss.str()));
+    auto& file = settingsStore->getFile();
+    file.setValue("scale", scale);
+    file.setValue("width", plugWidth);
+    file.setValue("height", plugHeight);
+    for (int i = 0; i < PAINT_PATS; ++i) {
+        if (paintPatterns[i] != nullptr) {
+            paintStore->set(i, paintPatterns[i]->points);
+            paintSources[i] = paintStore->get(i);
         }
     }
-    settings.saveIfNeeded();
+    paintStore->save(file);
+    settingsStore->scheduleSave();
 }
 
 void GATE12AudioProcessor::setScale(float s)
@@ -204,7 +165,7 @@ void GATE12AudioProcessor::createUndoPoint(int patindex)
             patterns[patindex]->createUndo();
         }
         else {
-            paintPatterns[patindex - 100]->createUndo();
+            getPaintPatern(patindex - PAINT_PATS_IDX)->createUndo();
         }
     }
     sendChangeMessage(); // UI repaint
@@ -243,7 +204,7 @@ void GATE12AudioProcessor::setUIMode(UIMode mode)
             showSequencer = false;
         }
         else if (mode == UIMode::PaintEdit) {
-            viewPattern = paintPatterns[paintTool];
+            viewPattern = getPaintPatern(paintTool);
             showPaintWidget = true;
             showSequencer = false;
         }
@@ -286,18 +247,54 @@ void GATE12AudioProcessor::toggleSequencerMode()
     );
 }
 
+// patterns and sequencer keep their own seed, randomizing one does not lose the seed of the other
+uint64_t GATE12AudioProcessor::newPatternSeed()
+{
+    patternSeed = seeds.next();
+    return patternSeed;
+}
+
+uint64_t GATE12AudioProcessor::newSequencerSeed()
+{
+    sequencerSeed = seeds.next();
+    return sequencerSeed;
+}
+
+// paint patterns are copied from the shared store the first time they are used
 Pattern* GATE12AudioProcessor::getPaintPatern(int index)
 {
+    if (paintPatterns[index] == nullptr) {
+        paintPatterns[index] = new Pattern(index + PAINT_PATS_IDX);
+        paintPatterns[index]->history.setBudget(undoBudget);
+        resetPaintPattern(index);
+    }
     return paintPatterns[index];
 }
 
+void GATE12AudioProcessor::resetPaintPattern(int index)
+{
+    auto pat = paintPatterns[index];
+    auto points = paintStore->get(index);
+    pat->clear();
+    pat->clearUndo();
+    pat->insertPoints(*points);
+    pat->setTension(
+        (double)params.getRawParameterValue("tension")->load(),
+        (double)params.getRawParameterValue("tensionatk")->load(),
+        (double)params.getRawParameterValue("tensionrel")->load(),
+        dualTension
+    );
+    pat->buildSegments();
+    paintSources[index] = points;
+}
+
 void GATE12AudioProcessor::setViewPattern(int index)
 {
     if (index >= 0 && index < 12) {
         viewPattern = patterns[index];
     }
     else if (index >= PAINT_PATS && index < PAINT_PATS_IDX + PAINT_PATS) {
-        viewPattern = paintPatterns[index - PAINT_PATS_IDX];
+        viewPattern = getPaintPatern(index - PAINT_PATS_IDX);
     }
     sendChangeMessage();
 }
@@ -306,21 +303,18 @@ void GATE12AudioProcessor::setPaintTool(int index)
 {
     paintTool = index;
     if (uimode == UIMode::PaintEdit) {
-        viewPattern = paintPatterns[index];
+        viewPattern = getPaintPatern(index);
         sendChangeMessage();
     }
 }
 
 void GATE12AudioProcessor::restorePaintPatterns()
 {
+    paintStore->restorePresets();
     for (int i = 0; i < 8; ++i) {
-        paintPatterns[i]->clear();
-        paintPatterns[i]->clearUndo();
-        auto preset = Presets::getPaintPreset(i);
-        for (auto& point : preset) {
-            paintPatterns[i]->insertPoint(point.x, point.y, point.tension, point.type);
+        if (paintPatterns[i] != nullptr) {
+            resetPaintPattern(i);
         }
-        paintPatterns[i]->buildSegments();
     }
     sendChangeMessage();
 }
@@ -386,11 +380,9 @@ void GATE12AudioProcessor::loadProgram (int index)
 
     currentProgram = index;
     auto loadPreset = [](Pattern& pat, int idx) {
-        auto preset = Presets::getPreset(idx);
         pat.clear();
-        for (auto p = preset.begin(); p < preset.end(); ++p) {
-            pat.insertPoint(p->x, p->y, p->tension, p->type);
-        }
+        auto preset = Presets::getPreset(idx);
+        pat.insertPoints(preset.begin(), preset.end());
         pat.buildSegments();
         pat.clearUndo();
     };
@@ -415,6 +407,41 @@ void GATE12AudioProcessor::loadProgram (int index)
     sendChangeMessage(); // UI Repaint
 }
 
+// replaces a pattern slot with points from the pattern library
+void GATE12AudioProcessor::loadLibraryPattern(int slot, const std::vector<PPoint>& points)
+{
+    if (slot < 0 || slot >= 12 || points.empty())
+        return;
+
+    if (sequencer->isOpen)
+        sequencer->close();
+
+    // the live pattern is replaced at a block boundary like a restored state
+    // the undo point is taken when the points are swapped so it has any edit made meanwhile
+    auto set = std::make_unique<PatternSet>();
+    set->slotMask = 1 << slot;
+    set->undoMask = 1 << slot;
+    set->currpattern = 0;
+    auto& pts = set->points[slot];
+    auto id = Pattern::newPointIDs(points.size());
+    pts.reserve(points.size());
+    for (auto& point : points) {
+        pts.push_back({ id++, point.x, point.y, point.tension, point.type });
+    }
+    std::stable_sort(pts.begin(), pts.end(), [](const PPoint& a, const PPoint& b) { return a.x < b.x; });
+    set->segments[slot] = Pattern::makeSegments(pts);
+    publishPatternSet(std::move(set));
+
+    setUIMode(UIMode::Normal);
+    sendChangeMessage(); // UI Repaint
+}
+
+// library folder next to the settings file
+File GATE12AudioProcessor::getLibraryFolder()
+{
+    return settingsStore->getFile().getFile().getSiblingFile("Library");
+}
+
 const juce::String GATE12AudioProcessor::getProgramName (int index)
 {
     static const std::array<juce::String, 40> progNames = {
@@ -439,13 +466,13 @@ void GATE12AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock
     rawBuffer.setSize(2, samplesPerBlock);
     lowBuffer.setSize(2, samplesPerBlock);
     highBuffer.setSize(2, samplesPerBlock);
-    lpFilterL.clear(0.0);
-    lpFilterR.clear(0.0);
-    hpFilterL.clear(0.0);
-    hpFilterR.clear(0.0);
+    detectBuffer.setSize(2, samplesPerBlock);
+    detectFilter.clear();
     transDetectorL.clear(sampleRate);
     transDetectorR.clear(sampleRate);
-    std::fill(monSamples.begin(), monSamples.end(), 0.0);
+    monColumn = { 0.f, 0.f };
+    monpos = 0.0;
+    spectrum.setSampleRate(sampleRate);
     onSlider(); // sets latency on first run
 }
 
@@ -546,10 +573,7 @@ void GATE12AudioProcessor::onSlider()
 
     auto highcut = (double)params.getRawParameterValue("highcut")->load();
     auto lowcut = (double)params.getRawParameterValue("lowcut")->load();
-    lpFilterL.lp(srate, highcut, 0.707);
-    lpFilterR.lp(srate, highcut, 0.707);
-    hpFilterL.hp(srate, lowcut, 0.707);
-    hpFilterR.hp(srate, lowcut, 0.707);
+    detectFilter.setup(srate, lowcut, highcut);
 
     float splitLow = params.getRawParameterValue("split_low")->load();
     float splitHigh = params.getRawParameterValue("split_high")->load();
@@ -564,9 +588,11 @@ void GATE12AudioProcessor::onTensionChange()
     auto tensionrel = (double)params.getRawParameterValue("tensionrel")->load();
     pattern->setTension(tension, tensionatk, tensionrel, dualTension);
     pattern->buildSegments();
-    for (int i = 0; i < PAINT_PATS; ++i) {
-        paintPatterns[i]->setTension(tension, tensionatk, tensionrel, dualTension);
-        paintPatterns[i]->buildSegments();
+    for (auto* paintPattern : paintPatterns) {
+        if (paintPattern != nullptr) {
+            paintPattern->setTension(tension, tensionatk, tensionrel, dualTension);
+            paintPattern->buildSegments();
+        }
     }
 }
 
@@ -588,12 +614,14 @@ void GATE12AudioProcessor::onPlay()
     beatPos = ppqPosition;
     ratePos = beatPos * secondsPerBeat * ratehz;
     trigpos = 0.0;
-    trigposSinceHit = 1.0;
     trigphase = phase;
 
     audioTriggerCountdown = -1;
+    xfadeCountdown = -1;
     transDetectorL.clear((double)srate);
     transDetectorR.clear((double)srate);
+    audioRetrigger.clear();
+    midiRetrigger.clear();
 
     if (trigger == Trigger::Sync || alwaysPlaying) {
         restartEnv(false);
@@ -636,9 +664,8 @@ void GATE12AudioProcessor::onStop()
 
 void GATE12AudioProcessor::clearDrawBuffers()
 {
-    std::fill(preSamples.begin(), preSamples.end(), 0.0);
-    std::fill(postSamples.begin(), postSamples.end(), 0.0);
-    std::fill(sideSamples.begin(), sideSamples.end(), 0.0);
+    waveColumn = { -1, 0.f, 0.f, 0.f };
+    waveColumns.push(waveColumn); // tells the view to clear its waveforms
 }
 
 void GATE12AudioProcessor::clearLatencyBuffers()
@@ -648,25 +675,20 @@ void GATE12AudioProcessor::clearLatencyBuffers()
     latBufferR.resize(latency, 0.0);
     latMonitorBufferL.resize(latency, 0.0);
     latMonitorBufferR.resize(latency, 0.0);
+    latEnvBuffer.resize(latency, 0.0);
     latpos = 0;
 }
 
 void GATE12AudioProcessor::toggleUseSidechain()
 {
     useSidechain = !useSidechain;
-    hpFilterL.clear(0.0);
-    hpFilterR.clear(0.0);
-    lpFilterL.clear(0.0);
-    lpFilterR.clear(0.0);
+    detectFilter.clear();
 }
 
 void GATE12AudioProcessor::toggleMonitorSidechain()
 {
     useMonitor = !useMonitor;
-    hpFilterL.clear(0.0);
-    hpFilterR.clear(0.0);
-    lpFilterL.clear(0.0);
-    lpFilterR.clear(0.0);
+    detectFilter.clear();
 }
 
 double inline GATE12AudioProcessor::getY(double x, double min, double max)
@@ -674,6 +696,28 @@ double inline GATE12AudioProcessor::getY(double x, double min, double max)
     return min + (max - min) * (1 - pattern->get_y_at(x));
 }
 
+/*
+    Returns the pattern min scaled by the detector envelope
+    the envelope is normalized to the audio threshold so hits above threshold use the full depth
+*/
+double GATE12AudioProcessor::getEnvDepthMin(double env, double threshold, double min, double max)
+{
+    double depth = threshold > 0.0 ? std::min(1.0, env / threshold) : 1.0;
+    if (envDepthMode == 2)
+        depth = 1.0 - depth;
+    return max - (max - min) * depth;
+}
+
+/*
+    Blends the previous envelope at x into the restarted envelope value y
+*/
+double GATE12AudioProcessor::getCrossfadeY(double y, double x, double min, double max)
+{
+    double t = 1.0 - (double)xfadeCountdown / (double)std::max(1, xfadeSamples);
+    double prev = getY(x, min, max);
+    return prev + (y - prev) * t;
+}
+
 void GATE12AudioProcessor::setSmooth()
 {
     float attack = 0;
@@ -695,7 +739,11 @@ void GATE12AudioProcessor::setSmooth()
     value2->setup(attack * 0.25, release * 0.25, (double)srate);
 }
 
-void GATE12AudioProcessor::startMidiTrigger()
+/*
+    Starts the anti-click countdown, the envelope restarts once it completes
+    with crossfade the running envelope keeps playing instead of tweening to the start value
+*/
+void GATE12AudioProcessor::startTrigger(double min, double max, bool crossfade)
 {
     double phase = (double)params.getRawParameterValue("phase")->load();
     if (phase < 1e-7) phase += 1e-7; // FIX zero points usually have a very tiny offset
@@ -703,8 +751,7 @@ void GATE12AudioProcessor::startMidiTrigger()
     stereo += phase; 
     if (stereo < 0.0) stereo += 1.0;
     if (stereo > 1.0) stereo -= 1.0;
-    double min = (double)params.getRawParameterValue("min")->load();
-    double max = (double)params.getRawParameterValue("max")->load();
+    xfadeRetrigger = crossfade;
     antiClickCooldown = getAntiClickLatency();
     antiClickSamples = antiClickCooldown;
     antiClickStart = ypos;
@@ -757,7 +804,6 @@ bool GATE12AudioProcessor::supportsDoublePrecisionProcessing() const
 void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals disableDenormals;
-    int sblock = getBlockSize();
     bool looping = false;
     double loopStart = 0.0;
     double loopEnd = 0.0;
@@ -793,6 +839,20 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
         }
     }
 
+    // adopt restored segments, the points are swapped and the replaced data freed on the message thread
+    lastBlockMillis.store(Time::getMillisecondCounter());
+    if (adoptedPatterns.load() == nullptr) {
+        if (auto* set = pendingPatterns.exchange(nullptr)) {
+            swapPatternSegments(*set);
+            if (set->currpattern > 0) {
+                queuedPattern = set->currpattern;
+                queuedPatternCountdown = 0;
+            }
+            adoptedPatterns.store(set);
+            triggerAsyncUpdate();
+        }
+    }
+
     int inputBusCount = getBusCount(true);
     int audioOutputs = getTotalNumOutputChannels();
     int audioInputs = inputBusCount > 0 ? getChannelCountOfBus(true, 0) : 0;
@@ -808,68 +868,59 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
     double max = (double)params.getRawParameterValue("max")->load();
     double ratehz = (double)params.getRawParameterValue("rate")->load();
     double phase = (double)params.getRawParameterValue("phase")->load();
-    double lowcut = (double)params.getRawParameterValue("lowcut")->load();
-    double highcut = (double)params.getRawParameterValue("highcut")->load();
     int algo = (int)params.getRawParameterValue("algo")->load();
     double threshold = (double)params.getRawParameterValue("threshold")->load();
     double sense = 1.0 - (double)params.getRawParameterValue("sense")->load();
     double stereo = (double)params.getRawParameterValue("stereo")->load() / 360.0;
     int splitSlope = (int)params.getRawParameterValue("split_slope")->load();
     sense = std::pow(sense, 2); // make sensitivity more responsive
+    bool useEnvDepth = envDepthMode != 0;
     int numSamples = buffer.getNumSamples();
 
-    // processes draw wave samples
+    // some hosts send blocks larger than the size passed to prepareToPlay
+    if (numSamples > detectBuffer.getNumSamples()) {
+        rawBuffer.setSize(2, numSamples, false, false, true);
+        lowBuffer.setSize(2, numSamples, false, false, true);
+        highBuffer.setSize(2, numSamples, false, false, true);
+        detectBuffer.setSize(2, numSamples, false, false, true);
+    }
+
+    // processes draw wave samples, completed columns are sent to the view
     auto processDisplaySample = [&](double pos, double env, double env2, double lsamp, double rsamp) {
         auto preamp = std::max(std::fabs(lsamp), std::fabs(rsamp));
         auto postamp = std::max(std::fabs(lsamp * env), std::fabs(rsamp * env2));
-        winpos = (int)std::floor(pos * viewW);
-        if (lwinpos != winpos) {
-            preSamples[winpos] = 0.0;
-            postSamples[winpos] = 0.0;
+        int winpos = (int)std::floor(pos * viewW);
+        if (waveColumn.pos != winpos) {
+            if (waveColumn.pos >= 0)
+                waveColumns.push(waveColumn);
+            waveColumn = { winpos, 0.f, 0.f, 0.f };
         }
-        lwinpos = winpos;
-        if (preSamples[winpos] < preamp)
-            preSamples[winpos] = preamp;
-        if (postSamples[winpos] < postamp)
-            postSamples[winpos] = postamp;
+        waveColumn.pre = std::max(waveColumn.pre, (float)preamp);
+        waveColumn.post = std::max(waveColumn.post, (float)postamp);
     };
 
-    // sidechain display
-    auto processSideDisplaySample = [&](double pos, int samp) {
+    // sidechain display, written to the same column as the last display sample
+    auto processSideDisplaySample = [&](int samp) {
         if (!sideInputs) return;
         auto lsamp = buffer.getSample(audioInputs, samp);
         auto rsamp = buffer.getSample(sideInputs > 1 ? audioInputs + 1 : audioInputs, samp);
         auto ampvalue = std::max(std::fabs(lsamp), std::fabs(rsamp));
-
-        sidewinpos = (int)std::floor(pos * viewW);
-        if (lsidewinpos != sidewinpos) {
-            sideSamples[sidewinpos] = 0.0;
-        }
-        lsidewinpos = sidewinpos;
-        if (sideSamples[sidewinpos] < ampvalue) {
-            sideSamples[sidewinpos] = ampvalue;
-        }
+        waveColumn.side = std::max(waveColumn.side, ampvalue);
     };
 
     double monIncrementPerSample = 1.0 / ((srate * 2) / monW); // 2 seconds of audio displayed on monitor
     auto processMonitorSample = [&](double lsamp, double rsamp, bool hit) {
-        double indexd = monpos.load();
-        indexd += monIncrementPerSample;
-
-        if (indexd >= monW)
-            indexd -= monW;
-
-        int index = (int)indexd;
-        if (lmonpos != index)
-            monSamples[index] = 0.0;
-        lmonpos = index;
-
-        double maxamp = std::max(std::fabs(lsamp), std::fabs(rsamp));
-        if (hit || monSamples[index] >= 10.0)
-            maxamp = std::max(maxamp + 10.0, hitamp + 10.0); // encode hits by adding +10 to amp
+        monpos += monIncrementPerSample;
+        if (monpos >= 1.0) {
+            monpos -= std::floor(monpos);
+            monColumns.push(monColumn);
+            monColumn = { 0.f, 0.f };
+        }
 
-        monSamples[index] = std::max(monSamples[index], maxamp);
-        monpos.store(indexd);
+        auto maxamp = (float)std::max(std::fabs(lsamp), std::fabs(rsamp));
+        monColumn.peak = std::max(monColumn.peak, maxamp);
+        if (hit)
+            monColumn.hit = std::max({ monColumn.hit, maxamp, (float)hitamp });
     };
 
     // applies envelope to a sample index
@@ -905,18 +956,16 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
         }
     }
 
-    // Process midi out queue
-    for (auto it = midiOut.begin(); it != midiOut.end();) {
-        auto& [msg, offset] = *it;
-
-        if (offset < sblock) {
-            midiMessages.addEvent(msg, offset);
-            it = midiOut.erase(it);
-        }
-        else {
-            offset -= sblock;
-            ++it;
+    // Process midi out queue, entries are not in time order after the note length changes
+    // sent entries are replaced by the last one, the queue never shifts or allocates
+    for (int i = 0; i < midiOutCount;) {
+        auto offset = midiOut[i].time - sampleClock;
+        if (offset >= numSamples) {
+            ++i;
+            continue;
         }
+        midiMessages.addEvent(midiOut[i].msg, (int)std::max((int64_t)0, offset));
+        midiOut[i] = midiOut[--midiOutCount];
     }
 
     // remove midi in messages that have been processed
@@ -963,12 +1012,44 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
         );
     }
 
+    // detection signal, the sidechain or the raw input filtered by lowcut and highcut
+    // read by the audio trigger and by the envelope depth in every trigger mode
+    bool detecting = trigger == Trigger::Audio || useEnvDepth;
+    if (detecting && useSidechain && sideInputs) {
+        detectFilter.processBlock(
+            buffer.getReadPointer(audioInputs),
+            buffer.getReadPointer(sideInputs > 1 ? audioInputs + 1 : audioInputs),
+            detectBuffer.getWritePointer(0),
+            detectBuffer.getWritePointer(1),
+            numSamples
+        );
+    }
+    else if (detecting) {
+        detectFilter.processBlock(
+            rawBuffer.getReadPointer(0),
+            rawBuffer.getReadPointer(1),
+            detectBuffer.getWritePointer(0),
+            detectBuffer.getWritePointer(1),
+            numSamples
+        );
+    }
+
     for (int sample = 0; sample < numSamples; ++sample) {
         if (playing && looping && beatPos >= loopEnd && trigger != Trigger::Free) {
             beatPos = loopStart + (beatPos - loopEnd);
             ratePos = beatPos * secondsPerBeat * ratehz;
         }
 
+        // pattern depth driven by the detector envelope
+        // in Audio mode the envelope is read from the latency buffer instead
+        double envmin = min;
+        if (useEnvDepth && trigger != Trigger::Audio) {
+            transDetectorL.detect(algo, detectBuffer.getSample(0, sample), threshold, sense);
+            transDetectorR.detect(algo, detectBuffer.getSample(1, sample), threshold, sense);
+            double env = std::max(transDetectorL.getEnvelope(algo), transDetectorR.getEnvelope(algo));
+            envmin = getEnvDepthMin(env, threshold, min, max);
+        }
+
         // process midi in queue
         for (auto& msg : midiIn) {
             if (msg.offset == 0) {
@@ -977,12 +1058,17 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                         auto patidx = msg.note % 12;
                         queuePattern(patidx + 1);
                     }
-                    if (trigger == Trigger::MIDI && (msg.channel == midiTriggerChn || midiTriggerChn == 16)) {
-                        if (queuedPattern) {
-                            queuedMidiTrigger = true;
-                        }
-                        else {
-                            startMidiTrigger();
+                    if (trigger == Trigger::MIDI && (msg.channel == midiTriggerChn || midiTriggerChn == 16) &&
+                        midiRetrigger.passCooldown(sampleClock + sample, srate, samplesPerBeat))
+                    {
+                        auto action = midiRetrigger.onTrigger(midiTrigger, trigpos);
+                        if (action == RetriggerPolicy::Start || action == RetriggerPolicy::StartCrossfade) {
+                            if (queuedPattern) {
+                                queuedMidiTrigger = true;
+                            }
+                            else {
+                                startTrigger(envmin, max, action == RetriggerPolicy::StartCrossfade);
+                            }
                         }
                     }
                 }
@@ -1009,7 +1095,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                     });
                 queuedPattern = 0;
                 if (queuedMidiTrigger) {
-                    startMidiTrigger();
+                    startTrigger(envmin, max, false);
                     queuedMidiTrigger = false;
                 }
             }
@@ -1025,7 +1111,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                 : ratePos + phase;
 
             xpos -= std::floor(xpos);
-            double newypos = getY(xpos, min, max);
+            double newypos = getY(xpos, envmin, max);
             ypos = value->process(newypos, newypos > ypos);
             // stereo processing
             ypos2 = ypos;
@@ -1034,7 +1120,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                 xpos2 = xpos + stereo;
                 if (xpos2 < 0.0) xpos2 += 1;
                 xpos2 -= std::floor(xpos2);
-                double newypos2 = getY(xpos2, min, max);
+                double newypos2 = getY(xpos2, envmin, max);
                 ypos2 = value2->process(newypos2, newypos2 > ypos2);
             }
 
@@ -1042,7 +1128,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             auto rsample = (double)buffer.getSample(1 % audioInputs, sample);
             applyGain(sample, ypos, ypos2, lsample, rsample);
             processDisplaySample(xpos, ypos, ypos2, lsample, rsample);
-            processSideDisplaySample(xpos, sample);
+            processSideDisplaySample(sample);
         }
 
         // MIDI mode
@@ -1076,12 +1162,18 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
 
             trigpos += inc;
             xpos -= std::floor(xpos);
+            if (xfadeCountdown > 0) {
+                xfadeX += inc;
+                xfadeX -= std::floor(xfadeX);
+            }
 
             if (!alwaysPlaying) {
                 if (midiTrigger) {
                     if (trigpos >= 1.0) { // envelope finished, stop midiTrigger
                         midiTrigger = false;
                         xpos = phase ? phase : 1.0;
+                        if (midiRetrigger.onCycleEnd())
+                            startTrigger(envmin, max, false);
                     }
                 }
                 else {
@@ -1089,7 +1181,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                 }
             }
 
-            if (antiClickCooldown >= 0) {
+            if (antiClickCooldown >= 0 && !xfadeRetrigger) {
                 // anti-click
                 // tween ypos, the midi trigger will be restarted once the tween completes
                 ypos = tween_ease_inout((double)(antiClickSamples - antiClickCooldown), antiClickStart, antiClickTarget, (double)antiClickSamples);
@@ -1105,7 +1197,9 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             }
             else {
                 // otherwise get the normal yposition value
-                double newypos = getY(xpos, min, max);
+                double newypos = getY(xpos, envmin, max);
+                if (xfadeCountdown > 0)
+                    newypos = getCrossfadeY(newypos, xfadeX, envmin, max);
                 ypos = value->process(newypos, newypos > ypos);
                 // stereo processing
                 xpos2 = xpos;
@@ -1114,7 +1208,11 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                     xpos2 = xpos + stereo;
                     if (xpos2 < 0.0) xpos2 += 1;
                     xpos2 -= std::floor(xpos2);
-                    double newypos2 = getY(xpos2, min, max);
+                    double newypos2 = getY(xpos2, envmin, max);
+                    if (xfadeCountdown > 0) {
+                        double xfadeX2 = xfadeX + stereo;
+                        newypos2 = getCrossfadeY(newypos2, xfadeX2 - std::floor(xfadeX2), envmin, max);
+                    }
                     ypos2 = value2->process(newypos2, newypos2 > ypos2);
                 }
             }
@@ -1123,7 +1221,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             applyGain(sample, ypos, ypos2, lsample, rsample);
             double viewx = (alwaysPlaying || midiTrigger) ? xpos : (trigpos + trigphase) - std::floor(trigpos + trigphase);
             processDisplaySample(viewx, ypos, ypos2, lsample, rsample);
-            processSideDisplaySample(viewx, sample);
+            processSideDisplaySample(sample);
 
             if (latency > 0) {
                 latpos = (latpos + 1) % latency;
@@ -1140,37 +1238,21 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             latBufferL[latpos] = lsample;
             latBufferR[latpos] = rsample;
 
-            // read sidechain samples
-            double lsidesample = 0.0;
-            double rsidesample = 0.0;
-            if (useSidechain && sideInputs) {
-                lsidesample = (double)buffer.getSample(audioInputs, sample);
-                rsidesample = (double)buffer.getSample(sideInputs > 1 ? audioInputs + 1 : audioInputs, sample);
-            }
-
             // Detect audio transients
-            auto monSampleL = useSidechain ? lsidesample : rawBuffer.getSample(0, sample);
-            auto monSampleR = useSidechain ? rsidesample : rawBuffer.getSample(1, sample);
-            if (lowcut > 20.0) {
-                monSampleL = hpFilterL.df1(monSampleL);
-                monSampleR = hpFilterR.df1(monSampleR);
-            }
-            if (highcut < 20000.0) {
-                monSampleL = lpFilterL.df1(monSampleL);
-                monSampleR = lpFilterR.df1(monSampleR);
-            }
+            auto monSampleL = detectBuffer.getSample(0, sample);
+            auto monSampleR = detectBuffer.getSample(1, sample);
             latMonitorBufferL[latpos] = monSampleL;
             latMonitorBufferR[latpos] = monSampleR;
 
-            if (transDetectorL.detect(algo, monSampleL, threshold, sense) ||
-                transDetectorR.detect(algo, monSampleR, threshold, sense))
+            bool detected = transDetectorL.detect(algo, monSampleL, threshold, sense);
+            detected = transDetectorR.detect(algo, monSampleR, threshold, sense) || detected;
+            if (detected && audioRetrigger.passCooldown(sampleClock + sample, srate, samplesPerBeat))
             {
-                transDetectorL.startCooldown();
-                transDetectorR.startCooldown();
                 int offset = (int)(params.getRawParameterValue("offset")->load() * AUDIO_LATENCY_MILLIS / 1000.f * srate);
                 audioTriggerCountdown = std::max(0, int((AUDIO_LATENCY_MILLIS / 1000.0 * srate) + offset));
                 hitamp = transDetectorL.hit ? std::fabs(monSampleL) : std::fabs(monSampleR);
             }
+            latEnvBuffer[latpos] = std::max(transDetectorL.getEnvelope(algo), transDetectorR.getEnvelope(algo));
 
             // read the sample 'latency' samples ago
             int readPos = (latpos + 1) % latency;
@@ -1178,6 +1260,8 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             rsample = latBufferR[readPos];
             monSampleL = latMonitorBufferL[readPos];
             monSampleR = latMonitorBufferR[readPos];
+            if (useEnvDepth)
+                envmin = getEnvDepthMin(latEnvBuffer[readPos], threshold, min, max);
 
             // write delayed samples to buffer to later apply dry/wet mix
             for (int channel = 0; channel < audioOutputs; ++channel) {
@@ -1187,17 +1271,10 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             bool hit = audioTriggerCountdown == 0; // there was an audio transient trigger in this sample, not counting the anticlick lag
 
             // HIT - start another countdown, this time for anticlick
-            if (hit && (alwaysPlaying || !audioIgnoreHitsWhilePlaying || trigposSinceHit > 0.98)) {
-                antiClickCooldown = getAntiClickLatency();
-                antiClickSamples = antiClickCooldown;
-                antiClickStart = ypos;
-                auto ph = phase < 1e-7 ? 1e-7 : phase;
-                antiClickTarget = getY(ph, min, max);
-                antiClickStart2 = ypos2;
-                auto ster = stereo + ph;
-                if (ster > 1.0) ster -= 1.0;
-                if (ster < 0.0) ster += 1.0;
-                antiClickTarget2 = getY(ster, min, max);
+            if (hit) {
+                auto action = audioRetrigger.onTrigger(audioTrigger, trigpos);
+                if (action == RetriggerPolicy::Start || action == RetriggerPolicy::StartCrossfade)
+                    startTrigger(envmin, max, action == RetriggerPolicy::StartCrossfade);
             }
 
             processMonitorSample(monSampleL, monSampleR, antiClickCooldown == 0);
@@ -1209,32 +1286,46 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             xpos += inc;
 
             trigpos += inc;
-            trigposSinceHit += inc;
             xpos -= std::floor(xpos);
+            if (xfadeCountdown > 0) {
+                xfadeX += inc;
+                xfadeX -= std::floor(xfadeX);
+            }
 
             // send output midi notes on audio trigger hit
             if (antiClickCooldown == 0 && outputATMIDI > 0) {
-                auto noteOn = MidiMessage::noteOn(1, outputATMIDI - 1, (float)hitamp);
+                auto velocity = (uint8)std::clamp((int)std::round(hitamp * 127.0), 1, 127);
+                auto noteOn = MidiMessage::noteOn(1, outputATMIDI - 1, velocity);
                 midiMessages.addEvent(noteOn, sample);
 
-                auto offnoteDelay = static_cast<int>(srate * AUDIO_NOTE_LENGTH_MILLIS / 1000.0);
+                auto offnoteDelay = static_cast<int>(srate * outputATMIDILength / 1000.0);
                 int noteOffSample = sample + offnoteDelay;
                 auto noteOff = MidiMessage::noteOff(1, outputATMIDI - 1);
 
-                if (noteOffSample < sblock) {
+                if (noteOffSample < numSamples) {
                     midiMessages.addEvent(noteOff, noteOffSample);
                 }
-                else {
-                    int offset = noteOffSample - sblock;
-                    midiOut.push_back({ noteOff, offset });
+                else if (midiOutCount < MIDI_OUT_CAPACITY) {
+                    midiOut[midiOutCount++] = { noteOff, sampleClock + noteOffSample };
+                }
+                else { // queue is full, end the note early rather than leave it stuck
+                    midiMessages.addEvent(noteOff, numSamples - 1);
                 }
             }
 
+            // log hit timeline position, compensating the plugin latency
+            if (antiClickCooldown == 0 && playing) {
+                auto latency = getLatencySamples();
+                hitLog.push({ timeInSamples - latency, beatPos - latency * beatsPerSample, (float)std::min(1.0, hitamp) });
+            }
+
             if (!alwaysPlaying) {
                 if (audioTrigger) {
                     if (trigpos >= 1.0) { // envelope finished, stop trigger
                         audioTrigger = false;
                         xpos = phase ? phase : 1.0;
+                        if (audioRetrigger.onCycleEnd())
+                            startTrigger(envmin, max, false);
                     }
                 }
                 else {
@@ -1242,7 +1333,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                 }
             }
 
-            if (antiClickCooldown >= 0) {
+            if (antiClickCooldown >= 0 && !xfadeRetrigger) {
                 // anti-click
                 // tween ypos, the trigger will be start once the tween completes
                 ypos = tween_ease_inout((double)(antiClickSamples - antiClickCooldown), antiClickStart, antiClickTarget, (double)antiClickSamples);
@@ -1258,7 +1349,9 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
             }
             else {
                 // otherwise get the normal yposition value
-                double newypos = getY(xpos, min, max);
+                double newypos = getY(xpos, envmin, max);
+                if (xfadeCountdown > 0)
+                    newypos = getCrossfadeY(newypos, xfadeX, envmin, max);
                 ypos = value->process(newypos, newypos > ypos);
                 // stereo processing
                 xpos2 = xpos;
@@ -1267,7 +1360,11 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
                     xpos2 = xpos + stereo;
                     if (xpos2 < 0.0) xpos2 += 1;
                     xpos2 -= std::floor(xpos2);
-                    double newypos2 = getY(xpos2, min, max);
+                    double newypos2 = getY(xpos2, envmin, max);
+                    if (xfadeCountdown > 0) {
+                        double xfadeX2 = xfadeX + stereo;
+                        newypos2 = getCrossfadeY(newypos2, xfadeX2 - std::floor(xfadeX2), envmin, max);
+                    }
                     ypos2 = value2->process(newypos2, newypos2 > ypos2);
                 }
             }
@@ -1283,7 +1380,7 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
 
             double viewx = (alwaysPlaying || audioTrigger) ? xpos : (trigpos + trigphase) - std::floor(trigpos + trigphase);
             processDisplaySample(viewx, ypos, ypos2, lsample, rsample);
-            processSideDisplaySample(viewx, sample);
+            processSideDisplaySample(sample);
             latpos = (latpos + 1) % latency;
 
             if (audioTriggerCountdown > -1)
@@ -1300,21 +1397,29 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
         if (playing)
             timeInSamples += 1;
 
+        if (xfadeCountdown >= 0)
+            xfadeCountdown -= 1;
+
         if (antiClickCooldown >= 0) {
-            if (antiClickCooldown == 0 && trigger == MIDI) {
-                clearDrawBuffers();
-                midiTrigger = !alwaysPlaying;
-                trigpos = 0.0;
-                trigphase = phase;
-                restartEnv(true);
-            }
-            if (antiClickCooldown == 0 && trigger == Audio) {
+            if (antiClickCooldown == 0 && (trigger == MIDI || trigger == Audio)) {
+                if (xfadeRetrigger) {
+                    xfadeX = xpos;
+                    xfadeSamples = (int)(RETRIGGER_XFADE_MILLIS * srate / 1000.0);
+                    xfadeCountdown = xfadeSamples;
+                }
                 clearDrawBuffers();
-                audioTrigger = !alwaysPlaying;
+                if (trigger == MIDI)
+                    midiTrigger = !alwaysPlaying;
+                else
+                    audioTrigger = !alwaysPlaying;
                 trigpos = 0.0;
                 trigphase = phase;
-                trigposSinceHit = 0.0;
                 restartEnv(true);
+                if (xfadeRetrigger) {
+                    value->reset(ypos); // crossfade starts from the running envelope
+                    value2->reset(ypos2);
+                    xfadeRetrigger = false;
+                }
             }
             antiClickCooldown -= 1;
         }
@@ -1330,20 +1435,14 @@ void GATE12AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
         }
     }
 
-    // prepare FFT buffer for band splitter display
+    // send output to band splitter display analysis
     if (showBandsEditor) {
-        auto ch0 = buffer.getReadPointer(0);
-        auto ch1 = buffer.getReadPointer(audioInputs > 1 ? 1 : 0);
-        for (int i = 0; i < numSamples; ++i) {
-            bandsFFTBuffer[bandsFFTWriteIndex++] = 0.5f * (ch0[i] + ch1[i]);
-            bandsFFTWriteIndex %= bandsFFTBuffer.size();
-        }
-        bandsFFTReady.store(true, std::memory_order_release);
-    }
-    else {
-        std::fill(bandsFFTBuffer.begin(), bandsFFTBuffer.end(), 0.f);
+        spectrum.push(buffer.getReadPointer(0), buffer.getReadPointer(audioInputs > 1 ? 1 : 0), numSamples);
     }
 
+    sampleClock += numSamples;
+    if (waveColumn.pos >= 0)
+        waveColumns.push(waveColumn); // publish the column in progress, the view overwrites it when completed
     drawSeek.store(playing && (trigger == Trigger::Sync || midiTrigger || audioTrigger));
 }
 
@@ -1361,6 +1460,18 @@ juce::AudioProcessorEditor* GATE12AudioProcessor::createEditor()
 //==============================================================================
 void GATE12AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
+    StateCodec::write(createState(), destData);
+}
+
+// textPatterns writes patterns and cells in the legacy text format, used by the state benchmark app
+ValueTree GATE12AudioProcessor::createState(bool textPatterns)
+{
+    // restored sets not fully applied yet are the current state, newest first
+    // the lock keeps them alive, the audio thread only swaps their segments
+    std::lock_guard<std::mutex> lock(patternSetMtx);
+    auto* pending = pendingPatterns.load();
+    auto* adopted = adoptedPatterns.load();
+
     auto state = ValueTree("PluginState");
     state.appendChild(params.copyState(), nullptr);
     state.setProperty("version", PROJECT_VERSION, nullptr);
@@ -1375,50 +1486,50 @@ void GATE12AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     state.setProperty("outputCCChan", outputCCChan, nullptr);
     state.setProperty("outputCV", outputCV, nullptr);
     state.setProperty("outputATMIDI", outputATMIDI, nullptr);
+    state.setProperty("outputATMIDILength", outputATMIDILength, nullptr);
     state.setProperty("bipolarCC", bipolarCC, nullptr);
     state.setProperty("paintTool", paintTool, nullptr);
     state.setProperty("paintPage", paintPage, nullptr);
     state.setProperty("pointMode", pointMode, nullptr);
-    state.setProperty("audioIgnoreHitsWhilePlaying", audioIgnoreHitsWhilePlaying, nullptr);
+    state.setProperty("audioRetrigMode", audioRetrigger.mode, nullptr);
+    state.setProperty("audioRetrigCooldown", audioRetrigger.cooldownMillis, nullptr);
+    state.setProperty("audioRetrigCooldownBeats", audioRetrigger.cooldownBeats, nullptr);
+    state.setProperty("audioRetrigIgnoreUntil", audioRetrigger.ignoreUntil, nullptr);
+    state.setProperty("midiRetrigMode", midiRetrigger.mode, nullptr);
+    state.setProperty("midiRetrigCooldown", midiRetrigger.cooldownMillis, nullptr);
+    state.setProperty("midiRetrigCooldownBeats", midiRetrigger.cooldownBeats, nullptr);
+    state.setProperty("midiRetrigIgnoreUntil", midiRetrigger.ignoreUntil, nullptr);
+    state.setProperty("envDepthMode", envDepthMode, nullptr);
     state.setProperty("linkSeqToGrid", linkSeqToGrid, nullptr);
-    state.setProperty("currpattern", pattern->index + 1, nullptr);
+    state.setProperty("currpattern", pending && pending->currpattern > 0 ? pending->currpattern
+        : adopted && adopted->currpattern > 0 ? adopted->currpattern
+        : pattern->index + 1, nullptr);
     state.setProperty("antiClick", antiClick, nullptr);
     state.setProperty("midiTriggerChn", midiTriggerChn, nullptr);
     state.setProperty("drawSidechain", drawSidechain, nullptr);
+    state.setProperty("patternSeed", (int64)patternSeed, nullptr);
+    state.setProperty("sequencerSeed", (int64)sequencerSeed, nullptr);
+    state.setProperty("randomDensity", randomOptions.density, nullptr);
+    state.setProperty("randomSwing", randomOptions.swing, nullptr);
+    state.setProperty("randomProbability", randomOptions.probability, nullptr);
+    state.setProperty("randomTension", randomOptions.tension, nullptr);
 
     for (int i = 0; i < 12; ++i) {
-        std::ostringstream oss;
-        auto points = patterns[i]->points;
-
-        if (sequencer->isOpen && i == sequencer->patternIdx) {
-            points = sequencer->backup;
-        }
-
-        for (const auto& point : points) {
-            oss << point.x << " " << point.y << " " << point.tension << " " << point.type << " ";
-        }
-        state.setProperty("pattern" + juce::String(i), var(oss.str()), nullptr);
+        auto& points = pending && pending->hasSlot(i) ? pending->points[i]
+            : adopted && adopted->hasSlot(i) ? adopted->points[i]
+            : sequencer->isOpen && i == sequencer->patternIdx ? sequencer->backup
+            : patterns[i]->points;
+
+        state.setProperty("pattern" + juce::String(i), textPatterns
+            ? var(StateCodec::encodePointsText(points))
+            : var(StateCodec::encodePoints(points)), nullptr);
     }
 
-    // serialize sequencer cells
-    std::ostringstream oss;
-    for (const auto& cell : sequencer->cells) {
-        oss << cell.shape << ' '
-            << cell.lshape << ' '
-            << cell.ptool << ' '
-            << cell.invertx << ' '
-            << cell.minx << ' '
-            << cell.maxx << ' '
-            << cell.miny << ' '
-            << cell.maxy << ' '
-            << cell.tenatt << ' '
-            << cell.tenrel << ' '
-            << cell.skew << '\n';
-    }
-    state.setProperty("seqcells", var(oss.str()), nullptr);
+    state.setProperty("seqcells", textPatterns
+        ? var(StateCodec::encodeCellsText(sequencer->cells))
+        : var(StateCodec::encodeCells(sequencer->cells)), nullptr);
 
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    return state;
 }
 
 void GATE12AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -1427,9 +1538,7 @@ void GATE12AudioProcessor::setStateInformation (const void* data, int sizeInByte
         sequencer->close();
     }
 
-    std::unique_ptr<juce::XmlElement>xmlState (getXmlFromBinary (data, sizeInBytes));
-    if (!xmlState) return;
-    auto state = ValueTree::fromXml (*xmlState);
+    auto state = StateCodec::read(data, sizeInBytes);
     if (!state.isValid()) return;
 
     params.replaceState(state.getChild(0));
@@ -1446,58 +1555,66 @@ void GATE12AudioProcessor::setStateInformation (const void* data, int sizeInByte
         bipolarCC = (bool)state.getProperty("bipolarCC");
         outputCV = (bool)state.getProperty("outputCV");
         outputATMIDI = (int)state.getProperty("outputATMIDI");
+        outputATMIDILength = (int)state.getProperty("outputATMIDILength", AUDIO_NOTE_LENGTH_MILLIS);
         paintTool = (int)state.getProperty("paintTool");
         paintPage = (int)state.getProperty("paintPage");
         pointMode = state.hasProperty("pointMode") ? (int)state.getProperty("pointMode") : 1;
-        audioIgnoreHitsWhilePlaying = (bool)state.getProperty("audioIgnoreHitsWhilePlaying");
+        bool ignoreHitsWhilePlaying = (bool)state.getProperty("audioIgnoreHitsWhilePlaying", false); // legacy option
+        audioRetrigger.mode = (int)state.getProperty("audioRetrigMode", ignoreHitsWhilePlaying ? RetriggerMode::IgnoreUntil : RetriggerMode::Retrigger);
+        audioRetrigger.cooldownMillis = (double)state.getProperty("audioRetrigCooldown", AUDIO_COOLDOWN_MILLIS);
+        audioRetrigger.cooldownBeats = (double)state.getProperty("audioRetrigCooldownBeats", 0.0);
+        audioRetrigger.ignoreUntil = (double)state.getProperty("audioRetrigIgnoreUntil", 0.98);
+        midiRetrigger.mode = (int)state.getProperty("midiRetrigMode", RetriggerMode::Retrigger);
+        midiRetrigger.cooldownMillis = (double)state.getProperty("midiRetrigCooldown", 0.0);
+        midiRetrigger.cooldownBeats = (double)state.getProperty("midiRetrigCooldownBeats", 0.0);
+        midiRetrigger.ignoreUntil = (double)state.getProperty("midiRetrigIgnoreUntil", 0.98);
+        envDepthMode = (int)state.getProperty("envDepthMode", 0);
         linkSeqToGrid = state.hasProperty("linkSeqToGrid") ? (bool)state.getProperty("linkSeqToGrid") : true;
         antiClick = state.hasProperty("antiClick") ? (int)state.getProperty("antiClick") : 1;
         midiTriggerChn = (int)state.getProperty("midiTriggerChn");
         drawSidechain = (bool)state.getProperty("drawSidechain", true);
-
+        patternSeed = (uint64_t)(int64)state.getProperty("patternSeed", 0);
+        sequencerSeed = (uint64_t)(int64)state.getProperty("sequencerSeed", 0);
+        randomOptions.density = (double)state.getProperty("randomDensity", 1.0);
+        randomOptions.swing = (double)state.getProperty("randomSwing", 0.0);
+        randomOptions.probability = (double)state.getProperty("randomProbability", 1.0);
+        randomOptions.tension = (double)state.getProperty("randomTension", 0.0);
+
+        // build the new pattern set without touching the live patterns
+        auto set = std::make_unique<PatternSet>();
         for (int i = 0; i < 12; ++i) {
-            patterns[i]->clear();
-            patterns[i]->clearUndo();
-
-            auto str = state.getProperty("pattern" + String(i)).toString().toStdString();
-            if (!str.empty()) {
-                double x, y, tension;
-                int type;
-                std::istringstream iss(str);
-                while (iss >> x >> y >> tension >> type) {
-                    patterns[i]->insertPoint(x,y,tension,type, false);
+            std::vector<PPoint> points;
+            if (StateCodec::decodePoints(state.getProperty("pattern" + String(i)), points)) {
+                std::stable_sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) { return a.x < b.x; });
+                for (auto& point : points) {
+                    point.id = Pattern::newPointID();
                 }
             }
+            set->segments[i] = Pattern::makeSegments(points);
+            set->points[i] = std::move(points);
+        }
 
-            auto tension = (double)params.getRawParameterValue("tension")->load();
-            auto tensionatk = (double)params.getRawParameterValue("tensionatk")->load();
-            auto tensionrel = (double)params.getRawParameterValue("tensionrel")->load();
+        if (!state.hasProperty("currpattern"))
+            set->currpattern = (int)params.getRawParameterValue("pattern")->load();
+        else
+            set->currpattern = state.getProperty("currpattern");
+        set->currpattern = jlimit(1, 12, set->currpattern);
+        int currpattern = set->currpattern;
+
+        auto tension = (double)params.getRawParameterValue("tension")->load();
+        auto tensionatk = (double)params.getRawParameterValue("tensionatk")->load();
+        auto tensionrel = (double)params.getRawParameterValue("tensionrel")->load();
+        for (int i = 0; i < 12; ++i) {
+            patterns[i]->clearUndo();
             patterns[i]->setTension(tension, tensionatk, tensionrel, dualTension);
-            patterns[i]->buildSegments();
         }
 
         if (state.hasProperty("seqcells")) {
-            auto str = state.getProperty("seqcells").toString().toStdString();
-            sequencer->cells.clear();
-            std::istringstream iss(str);
-            Cell cell;
-            int shape, lshape;
-            while (iss >> shape >> lshape >> cell.ptool >> cell.invertx
-                >> cell.minx >> cell.maxx >> cell.miny >> cell.maxy >> cell.tenatt
-                >> cell.tenrel >> cell.skew)
-            {
-                cell.shape = static_cast<CellShape>(shape);
-                cell.lshape = static_cast<CellShape>(lshape);
-                sequencer->cells.push_back(cell);
-            }
+            StateCodec::decodeCells(state.getProperty("seqcells"), sequencer->cells);
         }
 
-        int currpattern = 1;
-        if (!state.hasProperty("currpattern"))
-            currpattern = (int)params.getRawParameterValue("pattern")->load();
-        else
-            currpattern = state.getProperty("currpattern");
-        queuePattern(currpattern);
+        publishPatternSet(std::move(set));
+
         auto param = params.getParameter("pattern");
         param->setValueNotifyingHost(param->convertTo0to1((float)currpattern));
     }
@@ -1505,6 +1622,99 @@ void GATE12AudioProcessor::setStateInformation (const void* data, int sizeInByte
     setUIMode(Normal);
 }
 
+bool GATE12AudioProcessor::isAudioRunning()
+{
+    auto lastBlock = lastBlockMillis.load();
+    return lastBlock != 0 && Time::getMillisecondCounter() - lastBlock <= 100;
+}
+
+// hands a pattern set to the audio thread, applied on the message thread when audio is not running
+void GATE12AudioProcessor::publishPatternSet(std::unique_ptr<PatternSet> set)
+{
+    {
+        std::lock_guard<std::mutex> lock(patternSetMtx);
+
+        // merge with a set the audio thread has not picked yet, the newer set wins on shared slots
+        std::unique_ptr<PatternSet> previous(pendingPatterns.exchange(nullptr));
+        if (previous) {
+            for (int i = 0; i < 12; ++i) {
+                if (!set->hasSlot(i) && previous->hasSlot(i)) {
+                    set->points[i] = std::move(previous->points[i]);
+                    set->segments[i] = std::move(previous->segments[i]);
+                    set->slotMask |= 1 << i;
+                    set->undoMask |= previous->undoMask & (1 << i);
+                }
+            }
+            if (set->currpattern == 0)
+                set->currpattern = previous->currpattern;
+        }
+
+        pendingPatterns.store(set.release());
+    }
+
+    if (!isAudioRunning()) {
+        if (MessageManager::existsAndIsCurrentThread())
+            onPatternSetApplied();
+        else
+            triggerAsyncUpdate();
+    }
+}
+
+// audio thread at the start of a block, or message thread when audio is not running
+void GATE12AudioProcessor::swapPatternSegments(PatternSet& set)
+{
+    for (int i = 0; i < 12; ++i) {
+        if (set.hasSlot(i))
+            set.curveVersions[i] = patterns[i]->swapSegments(set.segments[i]);
+    }
+}
+
+// message thread - the UI reads and edits points without locks, so they are only replaced here
+void GATE12AudioProcessor::swapPatternPoints(PatternSet& set)
+{
+    for (int i = 0; i < 12; ++i) {
+        if (!set.hasSlot(i))
+            continue;
+
+        auto* pat = patterns[i];
+        bool edited = pat->curveVersion.load() != set.curveVersions[i];
+        if ((set.undoMask >> i) & 1)
+            pat->createUndo();
+        pat->swapPoints(set.points[i]);
+        if (edited)
+            pat->buildSegments(); // edited after the segments swap, rebuild them from the new points
+        pat->incrementVersion(); // resets view selection
+    }
+}
+
+void GATE12AudioProcessor::handleAsyncUpdate()
+{
+    onPatternSetApplied();
+}
+
+// message thread - completes the set adopted by the audio thread
+// and applies a pending set directly when audio is not running, the restored pattern parameter queues its pattern
+void GATE12AudioProcessor::onPatternSetApplied()
+{
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(patternSetMtx);
+        if (std::unique_ptr<PatternSet> set{ adoptedPatterns.exchange(nullptr) }) {
+            swapPatternPoints(*set);
+            changed = true;
+        }
+        if (!isAudioRunning()) {
+            if (std::unique_ptr<PatternSet> set{ pendingPatterns.exchange(nullptr) }) {
+                swapPatternSegments(*set);
+                swapPatternPoints(*set);
+                changed = true;
+            }
+        }
+    }
+    if (changed)
+        sendChangeMessage();
+}
+
 void GATE12AudioProcessor::importPatterns()
 {
     if (sequencer->isOpen)
@@ -10,9 +10,11 @@
 
 #include <JuceHeader.h>
 #include <vector>
+#include <array>
 #include "dsp/Pattern.h"
-#include "dsp/Filter.h"
+#include "dsp/FilterBank.h"
 #include "dsp/Transient.h"
+#include "dsp/RetriggerPolicy.h"
 #include "dsp/Splitter.h"
 #include "Presets.h"
 #include <atomic>
@@ -20,6 +22,14 @@
 #include "Globals.h"
 #include "ui/Sequencer.h"
 #include "utils/PatternManager.h"
+#include "utils/HitLog.h"
+#include "utils/SPSCRing.h"
+#include "utils/PaintPatternStore.h"
+#include "utils/SettingsStore.h"
+#include "utils/PatternClipboard.h"
+#include "utils/Xoshiro.h"
+#include "utils/SpectrumAnalyzer.h"
+#include "utils/StateCodec.h"
 
 using namespace globals;
 
@@ -33,7 +43,34 @@ struct MidiInMsg {
 
 struct MidiOutMsg {
     MidiMessage msg;
-    int offset;
+    int64_t time; // sampleClock when the message is due
+};
+
+// Peak amplitudes of one view column, sent from audio to UI thread
+struct WaveColumn {
+    int pos; // view column index, -1 tells the view to clear its waveforms
+    float pre;
+    float post;
+    float side;
+};
+
+// Peak amplitude of one audio monitor column, sent from audio to UI thread
+struct MonitorColumn {
+    float peak;
+    float hit; // transient hit amplitude, zero when there was no hit in this column
+};
+
+// Patterns restored from a saved state or loaded from the library, built off the audio thread
+// the audio thread swaps the segments in at a block boundary, the points are swapped after on the message thread
+struct PatternSet {
+    std::vector<PPoint> points[12];
+    std::vector<Segment> segments[12];
+    uint64_t curveVersions[12] = {}; // curve version after the segments swap, a later edit means the segments are rebuilt
+    int slotMask = 0xfff; // one bit per pattern replaced by the set
+    int undoMask = 0; // one bit per pattern that gets an undo point before its points are replaced
+    int currpattern = 1; // pattern queued once the set is adopted, 0 keeps the current pattern
+
+    bool hasSlot(int i) const { return (slotMask >> i) & 1; }
 };
 
 enum Trigger {
@@ -108,6 +145,7 @@ class GATE12AudioProcessor
     , public AudioProcessorParameter::Listener
     , public ChangeBroadcaster
     , private juce::AudioProcessorValueTreeState::Listener
+    , private juce::AsyncUpdater
 {
 public:
     static constexpr int GRID_SIZES[] = {
@@ -115,6 +153,8 @@ public:
         6, 12, 24, 48,  // Triplet
     };
 
+    static constexpr int ATMIDI_NOTE_LENGTHS[] = { 10, 25, 50, 100, 250, 500 }; // millis
+
     // Plugin settings
     float scale = 1.0f; // UI scale factor
     int plugWidth = PLUG_WIDTH;
@@ -129,10 +169,13 @@ public:
     int triggerChn = 9; // Midi pattern trigger channel, defaults to channel 10
     bool useMonitor = false;
     bool useSidechain = false;
-    bool audioIgnoreHitsWhilePlaying = false;
+    RetriggerPolicy audioRetrigger{ AUDIO_COOLDOWN_MILLIS }; // what audio hits do while the envelope is playing
+    RetriggerPolicy midiRetrigger{}; // what MIDI notes do while the envelope is playing
+    int envDepthMode = 0; // scales pattern depth by the detector envelope, 0 = off, 1 = follow, 2 = inverted
     int outputCC = 0; // output CC, 0 is off, channel is outputCC - 1
     int outputCCChan = 0; // output CC channel, 0 is channel 1
     int outputATMIDI = 0; // audio trigger midi note output, 0 is off, 60 is C4
+    int outputATMIDILength = AUDIO_NOTE_LENGTH_MILLIS; // audio trigger midi note length in millis
     bool bipolarCC = false;
     bool outputCV = false;
     int paintTool = 0; // index of pattern used for paint mode
@@ -157,16 +200,14 @@ public:
     double ypos = 0.0; // envelope y pos (0..1)
     double ypos2 = 0.f; // stereo separated ypos (0..1)
     double trigpos = 0.0; // used by trigger (Audio and MIDI) to detect one one shot envelope play
-    double trigposSinceHit = 1.0; // used by audioIgnoreHitsWhilePlaying option
     double trigphase = 0.0; // phase when trigger occurs, used to sync the background wave draw
     bool queuedMidiTrigger = false;
     double syncQN = 1.0; // sync quarter notes
     int ltrigger = -1; // last trigger mode
     bool midiTrigger = false; // flag midi has triggered envelope
-    int winpos = 0;
-    int lwinpos = 0; // used to draw wave samples
-    int sidewinpos = 0; // used to draw sidechain samples
-    int lsidewinpos = 0;
+    WaveColumn waveColumn{ -1, 0.f, 0.f, 0.f }; // view column being written
+    MonitorColumn monColumn{ 0.f, 0.f }; // monitor column being written
+    double monpos = 0.0; // fractional position of the monitor column being written
     double ltension = -10.0;
     double ltensionatk = -10.0;
     double ltensionrel = -10.0;
@@ -179,6 +220,10 @@ public:
     double antiClickTarget = 0.0;
     double antiClickTarget2 = 0.0; // anti click for stereo separation
     int antiClickSamples = 0;
+    bool xfadeRetrigger = false; // current trigger crossfades from the running envelope instead of anti-click
+    int xfadeCountdown = -1;
+    int xfadeSamples = 0;
+    double xfadeX = 0.0; // x pos of the previous envelope during crossfade
 
     // Audio mode state
     bool audioTrigger = false; // flag audio has triggered envelope
@@ -187,12 +232,12 @@ public:
     std::vector<double> latBufferR; // latency buffer right
     std::vector<double> latMonitorBufferL; // latency buffer left
     std::vector<double> latMonitorBufferR; // latency buffer right
+    std::vector<double> latEnvBuffer; // latency buffer of detector envelope
     int latpos = 0; // latency buffer pos
-    Filter lpFilterL{};
-    Filter lpFilterR{};
-    Filter hpFilterL{};
-    Filter hpFilterR{};
+    FilterBank detectFilter{}; // lowcut and highcut applied to the detection signal
+    AudioBuffer<double> detectBuffer; // filtered detection signal of the current block
     double hitamp = 0.0; // used to display transient hits on monitor view
+    HitLog hitLog; // optional log of audio trigger hit timestamps
 
     // PlayHead state
     float srate = 44100.f;
@@ -207,20 +252,16 @@ public:
     double secondsPerBeat = 0.1;
 
     // UI State
-    std::vector<double> preSamples; // used by view to draw pre audio
-    std::vector<double> postSamples; // used by view to draw post audio
-    std::vector<double> sideSamples; // used by view to draw sidechain
-    int viewW = 1; // viewport width, used for buffers of samples to draw waveforms
+    SPSCRing<WaveColumn> waveColumns; // consumed by view to draw pre, post and sidechain waves, allocated by the view
+    int viewW = 1; // viewport width, used to map envelope position into view columns
     std::atomic<double> xenv = 0.0; // xpos copy using atomic
     std::atomic<double> xenv2 = 0.0; // xpos copy using atomic, stereo separated
     std::atomic<double> yenv = 0.0; // ypos copy using atomic
     std::atomic<double> yenv2 = 0.0; // ypos copy using atomic, stereo separated
     std::atomic<bool> drawSeek = false;
     std::atomic<bool> drawStereo = false;
-    std::vector<double> monSamples; // used to draw transients + waveform preview
-    std::atomic<double> monpos = 0.0; // write index of monitor circular buf
-    int lmonpos = 0; // last index
-    int monW = 1; // audio monitor width used to rotate monitor samples buffer
+    SPSCRing<MonitorColumn> monColumns; // consumed by audio display to draw transients + waveform preview, allocated by the display
+    int monW = 1; // audio monitor width, sets how many samples each monitor column spans
     UIMode uimode = UIMode::Normal; // ui mode
     UIMode luimode = UIMode::Normal; // last ui mode
     bool showAudioKnobs = false; // used by UI to toggle audio knobs
@@ -228,16 +269,18 @@ public:
     bool showBandsEditor = false;
     bool showSequencer = false;
     bool drawSidechain = true;
-    size_t bandsFFTWriteIndex = 0;
-    std::array<float, (1 << BANDS_FFT_ORDER) * 2> bandsFFTBuffer{};
-    std::atomic<bool> bandsFFTReady = false;
+    SpectrumAnalyzer spectrum; // band splitter display analysis
+    SharedResourcePointer<PatternClipboard> clipboard; // copy and paste between patterns of any instance
+    RandomOptions randomOptions; // pattern and sequencer randomization options, saved with the state
+    uint64_t patternSeed = 0; // seed of the last random pattern, saved with the state so it can be regenerated
+    uint64_t sequencerSeed = 0; // seed of the last sequencer randomization, saved with the state
 
     //==============================================================================
     GATE12AudioProcessor();
     ~GATE12AudioProcessor() override;
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
-    void loadSettings();
+    void loadSettings(bool checkFile = false);
     void saveSettings();
     void setScale(float value);
     int getCurrentGrid();
@@ -254,7 +297,9 @@ public:
     void restorePaintPatterns();
     void setAntiClick(int ac);
     int getAntiClickLatency();
-    void startMidiTrigger();
+    void startTrigger(double min, double max, bool crossfade);
+    uint64_t newPatternSeed();
+    uint64_t newSequencerSeed();
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -279,6 +324,8 @@ public:
     void toggleUseSidechain();
     void toggleMonitorSidechain();
     double getY(double x, double min, double max);
+    double getEnvDepthMin(double env, double threshold, double min, double max);
+    double getCrossfadeY(double y, double x, double min, double max);
     void queuePattern(int patidx);
 
     //==============================================================================
@@ -300,12 +347,15 @@ public:
     int getCurrentProgram() override;
     void setCurrentProgram (int index) override;
     void loadProgram(int index);
+    void loadLibraryPattern(int slot, const std::vector<PPoint>& points);
+    File getLibraryFolder();
     const String getProgramName (int index) override;
     void changeProgramName (int index, const String& newName) override;
 
     //==============================================================================
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
+    ValueTree createState(bool textPatterns = false);
     void exportPatterns();
     void importPatterns();
     //=========================================================
@@ -315,14 +365,31 @@ public:
 
 private:
     Pattern* patterns[12]; // audio process patterns
-    Pattern* paintPatterns[PAINT_PATS]; // paint mode patterns
+    Pattern* paintPatterns[PAINT_PATS] = {}; // paint mode patterns, created on first use
+    PaintPatternStore::Points paintSources[PAINT_PATS]; // shared points each paint pattern was copied from
+    SharedResourcePointer<PaintPatternStore> paintStore;
+    void resetPaintPattern(int index);
+    std::shared_ptr<UndoBudget> undoBudget = std::make_shared<UndoBudget>(); // memory budget shared by all undo histories
+    std::atomic<PatternSet*> pendingPatterns = nullptr; // restored patterns waiting for the audio thread
+    std::atomic<PatternSet*> adoptedPatterns = nullptr; // segments swapped by the audio thread, points waiting for the message thread
+    std::mutex patternSetMtx; // guards reading and freeing sets on the other threads, never taken by the audio thread
+    std::atomic<uint32> lastBlockMillis = 0; // time of the last processBlock, used to tell if audio is running
+    bool isAudioRunning();
+    void publishPatternSet(std::unique_ptr<PatternSet> set);
+    void swapPatternSegments(PatternSet& set);
+    void swapPatternPoints(PatternSet& set);
+    void onPatternSetApplied();
+    void handleAsyncUpdate() override;
     Transient transDetectorL;
     Transient transDetectorR;
     bool paramChanged = false; // flag that triggers on any param change
-    ApplicationProperties settings;
+    SharedResourcePointer<SettingsStore> settingsStore;
     std::vector<MidiInMsg> midiIn; // midi buffer used to process midi messages offset
-    std::vector<MidiOutMsg> midiOut;
+    std::array<MidiOutMsg, MIDI_OUT_CAPACITY> midiOut; // pending note offs that cross block boundaries, unordered
+    int midiOutCount = 0; // used slots of midiOut, entries are swap-removed when sent
+    int64_t sampleClock = 0; // samples processed, used to schedule midiOut messages and trigger cooldowns
     PatternManager patternManager;
+    Xoshiro seeds{ (uint64_t)Time::getHighResolutionTicks() ^ (uint64_t)(pointer_sized_int)this }; // per instance source of random seeds
 
     double tween_ease_inout(double t, double start, double target_, double duration) {
         if (duration < 1e-7) return target_;
@@ -15,6 +15,8 @@ public:
 	double df1(double sample);
 
 private:
+	friend class FilterBank; // reuses the coefficient design
+
 	double a1 = 0.0;
 	double a2 = 0.0;
 	double b0 = 0.0;
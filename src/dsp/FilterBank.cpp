@@ -0,0 +1,65 @@
+#include "FilterBank.h"
+#include "Filter.h"
+#include <algorithm>
+
+void FilterBank::setup(double srate, double lowcut, double highcut)
+{
+	bool hp = lowcut > 20.0;
+	bool lp = highcut < 20000.0;
+	if (hp != hpActive || lp != lpActive)
+		clear();
+
+	hpActive = hp;
+	lpActive = lp;
+
+	Filter f;
+	f.hp(srate, lowcut, 0.707);
+	setLanes(0, hpActive, f.b0, f.b1, f.b2, f.a1, f.a2);
+	f.lp(srate, highcut, 0.707);
+	setLanes(2, lpActive, f.b0, f.b1, f.b2, f.a1, f.a2);
+}
+
+// sets the coefficients of both channels of a stage, bypassed stages pass the input through
+void FilterBank::setLanes(int lane, bool active, double _b0, double _b1, double _b2, double _a1, double _a2)
+{
+	for (int i = lane; i < lane + 2; ++i) {
+		b0[i] = active ? _b0 : 1.0;
+		b1[i] = active ? _b1 : 0.0;
+		b2[i] = active ? _b2 : 0.0;
+		a1[i] = active ? _a1 : 0.0;
+		a2[i] = active ? _a2 : 0.0;
+	}
+}
+
+void FilterBank::clear()
+{
+	for (int i = 0; i < LANES; ++i) {
+		s1[i] = s2[i] = 0.0;
+		x[i] = y[i] = 0.0;
+	}
+}
+
+void FilterBank::processBlock(const float* inL, const float* inR, double* outL, double* outR, int numSamples)
+{
+	if (!hpActive && !lpActive) {
+		std::copy(inL, inL + numSamples, outL);
+		std::copy(inR, inR + numSamples, outR);
+		return;
+	}
+
+	for (int n = 0; n < numSamples; ++n) {
+		x[0] = (double)inL[n];
+		x[1] = (double)inR[n];
+		x[2] = y[0];
+		x[3] = y[1];
+
+		for (int i = 0; i < LANES; ++i) {
+			y[i] = b0[i] * x[i] + s1[i];
+			s1[i] = b1[i] * x[i] - a1[i] * y[i] + s2[i];
+			s2[i] = b2[i] * x[i] - a2[i] * y[i];
+		}
+
+		outL[n] = y[2];
+		outR[n] = y[3];
+	}
+}
@@ -0,0 +1,35 @@
+// Copyright 2025 tilr
+// Audio trigger filter bank
+// Lowcut and highcut biquads for both channels in transposed direct form II,
+// the four filters (hpL, hpR, lpL, lpR) are laid out as lanes so each sample
+// is a single vectorizable pass; the lowpass lanes are fed the highpass output
+// of the previous sample, adding one sample of delay to the detection path.
+#pragma once
+
+class FilterBank
+{
+public:
+	FilterBank() {};
+	~FilterBank() {};
+
+	void setup(double srate, double lowcut, double highcut);
+	void clear();
+	void processBlock(const float* inL, const float* inR, double* outL, double* outR, int numSamples);
+
+	bool hpActive = false; // false when lowcut is at its lower limit
+	bool lpActive = false; // false when highcut is at its upper limit
+
+private:
+	static constexpr int LANES = 4; // hpL, hpR, lpL, lpR
+	alignas(32) double b0[LANES]{ 1.0, 1.0, 1.0, 1.0 };
+	alignas(32) double b1[LANES]{};
+	alignas(32) double b2[LANES]{};
+	alignas(32) double a1[LANES]{};
+	alignas(32) double a2[LANES]{};
+	alignas(32) double s1[LANES]{};
+	alignas(32) double s2[LANES]{};
+	alignas(32) double x[LANES]{};
+	alignas(32) double y[LANES]{};
+
+	void setLanes(int lane, bool active, double _b0, double _b1, double _b2, double _a1, double _a2);
+};
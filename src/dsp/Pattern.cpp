@@ -11,8 +11,8 @@
 #include <cmath>
 #include <algorithm>
 #include "../PluginProcessor.h"
-
-std::vector<PPoint> Pattern::copy_pattern;
+#include "../utils/PatternClipboard.h"
+#include "../utils/Xoshiro.h"
 
 Pattern::Pattern(int i)
 {
@@ -22,13 +22,14 @@ Pattern::Pattern(int i)
 
 void Pattern::incrementVersion()
 {
-    versionID = versionIDCounter;
-    versionIDCounter += 1;
+    versionID = versionIDCounter.fetch_add(1, std::memory_order_relaxed);
 }
 
+// stable sort keeps the order of points with the same x, eg. vertical steps
 void Pattern::sortPoints()
 {
-    std::sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) {
+    pointIndexValid = false;
+    std::stable_sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) {
         return a.x < b.x;
     });
 }
@@ -36,7 +37,8 @@ void Pattern::sortPoints()
 void Pattern::sortPointsSafe()
 {
     std::lock_guard<std::mutex> lock(pointsmtx);
-    std::sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) {
+    pointIndexValid = false;
+    std::stable_sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) {
         return a.x < b.x;
     });
 }
@@ -48,46 +50,88 @@ void Pattern::setTension(double t, double tatk, double trel, bool dual)
     tensionAtk.store(tatk);
     tensionRel.store(trel);
     tensionMult.store(t);
+    curveVersion.fetch_add(1);
 }
 
 int Pattern::insertPoint(double x, double y, double tension, int type, bool sort)
 {
-    auto id = pointsIDCounter;
-    pointsIDCounter += 1;
+    auto id = newPointID();
 
     const PPoint p = { id, x, y, tension, type };
-    points.push_back(p);
-    if (sort)
-        sortPoints();
+    if (!sort) {
+        points.push_back(p);
+        if (pointIndexValid)
+            pointIndex[id] = (int)points.size() - 1;
+        return (int)points.size() - 1;
+    }
 
-    // return point index
-    auto pidx = std::find_if(points.begin(), points.end(), [id](const PPoint& p) { return p.id == id; });
-    return pidx == points.end() ? -1 : (int)std::distance(points.begin(), pidx);
+    // sorted insert after any points with the same x
+    // finding the position is O(log n), the insert moves the tail in one memmove, O(n)
+    // points stay a contiguous vector since segments, undo chunks and the UI index them,
+    // many points at once go through insertPoints, which merges them in a single pass
+    auto pos = std::upper_bound(points.begin(), points.end(), x,
+        [](double x, const PPoint& p) { return x < p.x; });
+    pos = points.insert(pos, p);
+    auto index = (int)std::distance(points.begin(), pos);
+    if (index == (int)points.size() - 1 && pointIndexValid)
+        pointIndex[id] = index;
+    else
+        pointIndexValid = false; // the points after it moved
+    return index;
 };
 
-void Pattern::removePoint(double x, double y)
+void Pattern::insertPoints(const std::vector<PPoint>& pts)
 {
-    for (size_t i = 0; i < points.size(); ++i) {
-        if (points[i].x == x && points[i].y == y) {
-            points.erase(points.begin() + i);
-            return;
-        }
+    insertPoints(pts.data(), pts.data() + pts.size());
+}
+
+// appends the new points and merges them with the existing ones in a single pass
+void Pattern::insertPoints(const PPoint* first, const PPoint* last)
+{
+    auto count = (size_t)(last - first);
+    auto mid = points.size();
+    auto id = newPointIDs(count);
+    points.reserve(points.size() + count);
+    for (auto it = first; it != last; ++it) {
+        points.push_back({ id++, it->x, it->y, it->tension, it->type });
     }
+
+    auto cmp = [](const PPoint& a, const PPoint& b) { return a.x < b.x; };
+    std::stable_sort(points.begin() + mid, points.end(), cmp);
+    std::inplace_merge(points.begin(), points.begin() + mid, points.end(), cmp);
+    pointIndexValid = false;
+}
+
+void Pattern::removePoint(double x, double y)
+{
+    auto it = std::find_if(points.begin(), points.end(),
+        [x, y](const PPoint& p) { return p.x == x && p.y == y; });
+    if (it != points.end())
+        removePoint((int)std::distance(points.begin(), it));
 }
 
 void Pattern::removePoint(int i) {
+    if (i == (int)points.size() - 1 && pointIndexValid)
+        pointIndex.erase(points[i].id);
+    else
+        pointIndexValid = false; // the points after it moved
     points.erase(points.begin() + i);
 }
 
 void Pattern::removePointsInRange(double x1, double x2)
 {
-    for (auto i = points.begin(); i != points.end(); ++i) {
-        if (i->x >= x1 && i->x <= x2) {
-            i = points.erase(i);
-            removePointsInRange(x1, x2);
-            return;
-        }
-    }
+    points.erase(std::remove_if(points.begin(), points.end(),
+        [x1, x2](const PPoint& p) { return p.x >= x1 && p.x <= x2; }),
+        points.end());
+    pointIndexValid = false;
+}
+
+void Pattern::removePoints(const std::unordered_set<uint64_t>& ids)
+{
+    points.erase(std::remove_if(points.begin(), points.end(),
+        [&ids](const PPoint& p) { return ids.count(p.id) > 0; }),
+        points.end());
+    pointIndexValid = false;
 }
 
 void Pattern::invert()
@@ -101,6 +145,7 @@ void Pattern::invert()
 void Pattern::reverse()
 {
     std::reverse(points.begin(), points.end());
+    pointIndexValid = false;
 
     double t0 = !points.empty() ? points[0].tension : 0.0;
     int type0 = !points.empty() ? points[0].type : 1;
@@ -135,9 +180,14 @@ void Pattern::rotate(double x) {
 
 void Pattern::doublePattern()
 {
-    auto pts = points;
-    for (auto& p : pts) {
-        insertPoint(p.x + 1.0, p.y, p.tension, p.type, false);
+    auto size = points.size();
+    auto id = newPointIDs(size);
+    points.reserve(size * 2);
+    for (size_t i = 0; i < size; ++i) {
+        auto p = points[i];
+        if (pointIndexValid)
+            pointIndex[id] = (int)points.size();
+        points.push_back({ id++, p.x + 1.0, p.y, p.tension, p.type });
     }
 
     for (auto& p : points) {
@@ -147,10 +197,20 @@ void Pattern::doublePattern()
     incrementVersion();
 }
 
+// replaces all points, pts must be sorted by x
+void Pattern::setPoints(std::vector<PPoint> pts)
+{
+    std::lock_guard<std::mutex> lock(pointsmtx);
+    points.swap(pts);
+    pointIndexValid = false;
+}
+
 void Pattern::clear()
 {
     std::lock_guard<std::mutex> lock(pointsmtx);
     points.clear();
+    pointIndex.clear();
+    pointIndexValid = true;
     incrementVersion();
 }
 
@@ -161,6 +221,19 @@ void Pattern::buildSegments()
         std::lock_guard<std::mutex> lock(pointsmtx);
         pts = points;
     }
+
+    // build outside the lock and swap, the audio thread only waits for the swap
+    auto segs = makeSegments(std::move(pts));
+    {
+        std::lock_guard<std::mutex> lock(mtx); // prevents crash while reading Y from another thread
+        segments.swap(segs);
+    }
+    curveVersion.fetch_add(1);
+}
+
+// segments of sorted points, used to build segments without touching a live pattern
+std::vector<Segment> Pattern::makeSegments(std::vector<PPoint> pts)
+{
     // add ghost points outside the 0..1 boundary
     // allows the pattern to repeat itself and rotate seamlessly
     if (pts.size() == 0) {
@@ -178,13 +251,50 @@ void Pattern::buildSegments()
         pts.push_back({0, p1.x + 1.0, p1.y, p1.tension, p1.type});
     }
 
-    std::lock_guard<std::mutex> lock(mtx); // prevents crash while reading Y from another thread
-    segments.clear();
+    std::vector<Segment> segs;
+    segs.reserve(pts.size() - 1);
     for (size_t i = 0; i < pts.size() - 1; ++i) {
         auto p1 = pts[i];
         auto p2 = pts[i + 1];
-        segments.push_back({p1.x, p2.x, p1.y, p2.y, p1.tension, 0, p1.type});
+        segs.push_back({p1.x, p2.x, p1.y, p2.y, p1.tension, 0, p1.type});
     }
+    return segs;
+}
+
+// swaps segments built elsewhere with the current ones, does not allocate
+// the previous segments are left in segs to be freed by the caller, returns the new curve version
+uint64_t Pattern::swapSegments(std::vector<Segment>& segs)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        segments.swap(segs);
+    }
+    return curveVersion.fetch_add(1) + 1;
+}
+
+// swaps points built elsewhere with the current ones, message thread only since the UI reads points unlocked
+// the previous points are left in pts to be freed by the caller
+void Pattern::swapPoints(std::vector<PPoint>& pts)
+{
+    {
+        std::lock_guard<std::mutex> lock(pointsmtx);
+        points.swap(pts);
+    }
+    pointIndexValid = false;
+    curveVersion.fetch_add(1);
+}
+
+// replaces points and segments in one swap with both locks held, message thread only
+// the previous points and segments are left in pts and segs to be freed by the caller
+void Pattern::publish(std::vector<PPoint>& pts, std::vector<Segment>& segs)
+{
+    {
+        std::scoped_lock lock(pointsmtx, mtx);
+        points.swap(pts);
+        segments.swap(segs);
+    }
+    pointIndexValid = false;
+    curveVersion.fetch_add(1);
 }
 
 // thread safe get segments
@@ -195,6 +305,55 @@ std::vector<Segment> Pattern::getSegments()
     return segments;
 }
 
+// segments overlapping x1..x2 paired with their index, segments are sorted by x
+std::vector<std::pair<int, Segment>> Pattern::getSegmentsInRange(double x1, double x2)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::pair<int, Segment>> result;
+    auto it = std::lower_bound(segments.begin(), segments.end(), x1,
+        [](const Segment& seg, double x) { return seg.x2 < x; });
+    for (; it != segments.end() && it->x1 <= x2; ++it) {
+        result.push_back({ (int)std::distance(segments.begin(), it), *it });
+    }
+    return result;
+}
+
+// index of point by id or -1 if not found
+// the map is updated by the pattern edits, edits that move points invalidate it
+// the UI also edits points directly, so a lookup that misses or finds another point rebuilds it once
+int Pattern::getPointIndex(uint64_t id)
+{
+    if (pointIndexValid) {
+        auto it = pointIndex.find(id);
+        if (it != pointIndex.end() && it->second < (int)points.size() && points[it->second].id == id)
+            return it->second;
+    }
+
+    rebuildPointIndex();
+    auto it = pointIndex.find(id);
+    return it == pointIndex.end() ? -1 : it->second;
+}
+
+void Pattern::rebuildPointIndex()
+{
+    pointIndex.clear();
+    pointIndex.reserve(points.size());
+    for (int i = 0; i < (int)points.size(); ++i) {
+        pointIndex[points[i].id] = i;
+    }
+    pointIndexValid = true;
+}
+
+// index range [first, last) of points with x between x1 and x2, points are sorted by x
+std::pair<int, int> Pattern::getPointsInRange(double x1, double x2)
+{
+    auto first = std::lower_bound(points.begin(), points.end(), x1,
+        [](const PPoint& p, double x) { return p.x < x; });
+    auto last = std::upper_bound(first, points.end(), x2,
+        [](double x, const PPoint& p) { return x < p.x; });
+    return { (int)std::distance(points.begin(), first), (int)std::distance(points.begin(), last) };
+}
+
 void Pattern::loadSine() {
     clear();
     insertPoint(0.0, 1, 0, 8);
@@ -210,27 +369,48 @@ void Pattern::loadTriangle() {
     insertPoint(1, 1, 0, 1);
 };
 
-void Pattern::loadRandom(int grid) {
+// the same seed and options always give the same pattern, every step draws the same
+// amount of numbers so changing an option does not reshuffle the other steps
+// points are appended in order, reserving only allocates when the pattern never held that many
+// buildSegments still allocates the new segments, as it does after any edit
+void Pattern::loadRandom(int grid, uint64_t seed, const RandomOptions& options) {
     clear();
-    auto y = static_cast<double>(rand())/RAND_MAX;
-    insertPoint(0, y, 0, 1);
-    insertPoint(1, y, 0, 1);
+    points.reserve(grid + 2);
+    Xoshiro rng(seed);
+    auto first = rng.nextDouble();
+    auto y = first;
+    insertPoint(0, y, 0, 1, false);
     for (auto i = 0; i < grid; ++i) {
-        auto r1 = static_cast<double>(rand()) / RAND_MAX;
-        auto r2 = static_cast<double>(rand()) / RAND_MAX;
-        insertPoint(std::min(0.9999999, std::max(0.000001, r1 / (double)grid + i / (double)grid)), r2, 0, 1);
+        auto r1 = rng.nextDouble();
+        auto r2 = rng.nextDouble();
+        auto r3 = rng.nextDouble();
+        auto filled = rng.nextBool(options.density);
+        auto changed = rng.nextBool(options.probability);
+        if (!filled)
+            continue;
+
+        auto swing = i % 2 == 1 ? options.swing * 0.5 : 0.0;
+        auto x = (i + swing + r1 * (1.0 - swing)) / (double)grid;
+        if (changed)
+            y = r2;
+        insertPoint(std::min(0.9999999, std::max(0.000001, x)), y, (r3 * 2.0 - 1.0) * options.tension, 1, false);
     }
+    insertPoint(1, first, 0, 1, false);
 };
 
-void Pattern::copy()
+void Pattern::copy(PatternClipboard& clipboard)
 {
-  copy_pattern = points;
+  clipboard.set(points);
 }
 
-void Pattern::paste()
+void Pattern::paste(const PatternClipboard& clipboard)
 {
-  if (copy_pattern.size() > 0) {
-    points = copy_pattern;
+  if (clipboard.get(points)) {
+    // pasted points are new points, the ids of the copied pattern are still in use
+    auto id = newPointIDs(points.size());
+    for (auto& point : points)
+      point.id = id++;
+    pointIndexValid = false;
     incrementVersion();
   }
 }
@@ -436,42 +616,31 @@ double Pattern::get_y_at(double x)
 
 void Pattern::createUndo()
 {
-    if (undoStack.size() > globals::MAX_UNDO) {
-        undoStack.erase(undoStack.begin());
-    }
-    undoStack.push_back(points);
-    redoStack.clear();
+    history.push(points);
 }
 void Pattern::undo()
 {
-    if (undoStack.empty())
+    if (!history.undo(points))
         return;
 
-    redoStack.push_back(points);
-    points = undoStack.back();
-    undoStack.pop_back();
-
+    pointIndexValid = false;
     incrementVersion();
     buildSegments();
 }
 
 void Pattern::redo()
 {
-    if (redoStack.empty())
+    if (!history.redo(points))
         return;
 
-    undoStack.push_back(points);
-    points = redoStack.back();
-    redoStack.pop_back();
-
+    pointIndexValid = false;
     incrementVersion();
     buildSegments();
 }
 
 void Pattern::clearUndo()
 {
-    undoStack.clear();
-    redoStack.clear();
+    history.clear();
 }
 
 bool Pattern::comparePoints(const std::vector<PPoint>& a, const std::vector<PPoint>& b)
@@ -11,6 +11,12 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include "../utils/UndoHistory.h"
+
+class PatternClipboard;
 
 enum PointType {
     Hold,
@@ -30,6 +36,18 @@ struct PPoint {
     double y;
     double tension;
     int type;
+
+    bool operator==(const PPoint& o) const {
+        return id == o.id && x == o.x && y == o.y && tension == o.tension && type == o.type;
+    }
+};
+
+// generative options of pattern and sequencer randomization
+struct RandomOptions {
+    double density = 1.0; // chance each step gets a point, sequencer silence mode keeps cells with this chance
+    double swing = 0.0; // delays odd steps up to half a step
+    double probability = 1.0; // chance a step changes value instead of holding, sequencer chance a cell is randomized
+    double tension = 0.0; // points get a random tension in -tension..tension
 };
 
 struct Segment {
@@ -46,13 +64,12 @@ class Pattern
 {
 public:
     uint64_t versionID = 0; // unique pattern ID, used by UI to detect pattern changes and update selection
-    static std::vector<PPoint> copy_pattern;
+    std::atomic<uint64_t> curveVersion = 0; // bumped whenever segments or tension change, used by UI to cache the curve
     static constexpr double PI = 3.14159265358979323846;
     int index;
     std::vector<PPoint> points;
     std::vector<Segment> segments;
-    std::vector<std::vector<PPoint>> undoStack;
-    std::vector<std::vector<PPoint>> redoStack;
+    UndoHistory<PPoint> history;
     std::atomic<double> tensionMult = 0.0; // tension multiplier applied to all points
     std::atomic<double> tensionAtk = 0.0; // tension multiplier for attack only
     std::atomic<double> tensionRel = 0.0; // tension multiplier for release only
@@ -61,24 +78,37 @@ public:
     void incrementVersion(); // generates a new unique ID for this pattern
 
     int insertPoint(double x, double y, double tension, int type, bool sort = true);
+    void insertPoints(const std::vector<PPoint>& pts); // bulk insert, new ids are assigned to the points
+    void insertPoints(const PPoint* first, const PPoint* last);
+    void setPoints(std::vector<PPoint> pts);
+    static uint64_t newPointID() { return pointsIDCounter.fetch_add(1, std::memory_order_relaxed); }
+    static uint64_t newPointIDs(size_t count) { return pointsIDCounter.fetch_add(count, std::memory_order_relaxed); } // first of count consecutive ids
     void sortPoints();
     void sortPointsSafe();
     void setTension(double t, double tatk, double trel, bool dual); // sets global tension multiplier
     void removePoint(double x, double y);
     void removePoint(int i);
     void removePointsInRange(double x1, double x2);
+    void removePoints(const std::unordered_set<uint64_t>& ids);
     void invert();
     void reverse();
     void doublePattern();
     void rotate(double x);
     void clear();
     void buildSegments();
+    static std::vector<Segment> makeSegments(std::vector<PPoint> pts);
+    uint64_t swapSegments(std::vector<Segment>& segs);
+    void swapPoints(std::vector<PPoint>& pts);
+    void publish(std::vector<PPoint>& pts, std::vector<Segment>& segs);
     void loadSine();
     void loadTriangle();
-    void loadRandom(int grid);
-    void copy();
-    void paste();
+    void loadRandom(int grid, uint64_t seed, const RandomOptions& options);
+    void copy(PatternClipboard& clipboard);
+    void paste(const PatternClipboard& clipboard);
     std::vector<Segment> getSegments();
+    std::vector<std::pair<int, Segment>> getSegmentsInRange(double x1, double x2);
+    int getPointIndex(uint64_t id);
+    std::pair<int, int> getPointsInRange(double x1, double x2);
     int getWaveCount(Segment seg);
 
     double get_y_curve(Segment seg, double x);
@@ -98,9 +128,12 @@ public:
     static bool comparePoints(const std::vector<PPoint>& a, const std::vector<PPoint>& b);
 
 private:
-    static inline uint64_t versionIDCounter = 1; // static global ID counter
-    static inline uint64_t pointsIDCounter = 1; // static global ID counter
+    static inline std::atomic<uint64_t> versionIDCounter = 1; // global ID counter, shared by all instances and threads
+    static inline std::atomic<uint64_t> pointsIDCounter = 1; // global ID counter, shared by all instances and threads
     bool dualTension = false;
     std::mutex mtx;
     std::mutex pointsmtx;
+    std::unordered_map<uint64_t, int> pointIndex; // point id to index, used by UI to find points by id
+    bool pointIndexValid = false; // cleared by edits that move points, the map is rebuilt on the next lookup
+    void rebuildPointIndex();
 };
\ No newline at end of file
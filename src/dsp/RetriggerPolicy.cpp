@@ -0,0 +1,60 @@
+#include "RetriggerPolicy.h"
+
+void RetriggerPolicy::clear()
+{
+	hasTriggered = false;
+	queued = false;
+}
+
+/*
+	Rate limits triggers, returns false if the trigger happened during the cooldown
+	of a previous one, otherwise the cooldown restarts from now
+*/
+bool RetriggerPolicy::passCooldown(int64_t now, double srate, double samplesPerBeat)
+{
+	auto cooldown = cooldownBeats > 0.0
+		? (int64_t)(cooldownBeats * samplesPerBeat)
+		: (int64_t)(cooldownMillis * srate / 1000.0);
+
+	if (hasTriggered && now - lastTrigger < cooldown)
+		return false;
+
+	lastTrigger = now;
+	hasTriggered = true;
+	return true;
+}
+
+/*
+	Decides what a trigger does
+	running - the envelope is playing a one shot cycle
+	progress - how much of the cycle has played (0..1)
+*/
+RetriggerPolicy::Action RetriggerPolicy::onTrigger(bool running, double progress)
+{
+	if (!running)
+		return Start;
+
+	if (mode == RetriggerMode::IgnoreUntil)
+		return progress >= ignoreUntil ? Start : Ignore;
+
+	if (mode == RetriggerMode::Crossfade)
+		return StartCrossfade;
+
+	if (mode == RetriggerMode::QueueNext) {
+		queued = true;
+		return Queue;
+	}
+
+	return Start;
+}
+
+/*
+	Called when the envelope cycle completes,
+	returns true if a queued trigger should start now
+*/
+bool RetriggerPolicy::onCycleEnd()
+{
+	bool start = queued;
+	queued = false;
+	return start;
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 tilr
+// Retrigger policy
+// Small state machine that decides what a trigger (audio hit or MIDI note) does,
+// it is only evaluated on trigger events and when the envelope completes
+#pragma once
+
+#include <cstdint>
+#include "../Globals.h"
+
+enum RetriggerMode {
+	Retrigger, // restart the envelope on every trigger
+	IgnoreUntil, // ignore triggers until the envelope has played ignoreUntil
+	Crossfade, // restart the envelope crossfading from the running one
+	QueueNext // hold the trigger until the running envelope completes
+};
+
+class RetriggerPolicy
+{
+public:
+	enum Action {
+		Ignore,
+		Start,
+		StartCrossfade,
+		Queue
+	};
+
+	RetriggerPolicy(double cooldown = 0.0) : cooldownMillis(cooldown) {};
+	~RetriggerPolicy() {};
+
+	int mode = RetriggerMode::Retrigger;
+	double cooldownMillis = 0.0; // min time between triggers
+	double cooldownBeats = 0.0; // min time between triggers in quarter notes, used instead of millis when > 0
+	double ignoreUntil = 0.98; // envelope progress (0..1) before triggers are accepted in IgnoreUntil mode
+
+	void clear();
+	bool passCooldown(int64_t now, double srate, double samplesPerBeat);
+	Action onTrigger(bool running, double progress);
+	bool onCycleEnd();
+
+private:
+	int64_t lastTrigger = 0;
+	bool hasTriggered = false;
+	bool queued = false;
+};
@@ -10,18 +10,12 @@ void Transient::clear(double sampleRate)
 	relAlpha = std::exp(-1.0 / (relTau * srate));
 	envelope = 0.0;
 	prevEnvelope = 0.0;
-	cooldown = 0;
     drumsBuf.resize((int)(srate * globals::AUDIO_DRUMSBUF_MILLIS / 1000.0), 0.0);
 	drumsBufIdx = 0;
 	energy = 0.0;
     prevEnergy = 0.0;
 }
 
-void Transient::startCooldown()
-{
-	cooldown = (int)(srate * globals::AUDIO_COOLDOWN_MILLIS / 1000.0);
-}
-
 bool Transient::detect(int algo, double sample, double thres, double sense)
 {
 	return algo == 0 
@@ -29,6 +23,12 @@ bool Transient::detect(int algo, double sample, double thres, double sense)
 		: detectDrums(sample, thres, sense);
 }
 
+// continuous detector level, the smoothed envelope for simple algo or the RMS for drums algo
+double Transient::getEnvelope(int algo) const
+{
+	return algo == 0 ? envelope : prevEnergy;
+}
+
 bool Transient::detectSimple(double sample, double thres, double sense)
 {
 	bool isAttack = std::fabs(sample) > envelope;
@@ -40,10 +40,7 @@ bool Transient::detectSimple(double sample, double thres, double sense)
 	prevEnvelope = envelope;
 
 	diff *= 10; // unscientific method to make diff more sensitive
-	if (cooldown)
-		cooldown -= 1; 
-
-	hit = !cooldown && diff > sense && std::fabs(sample) > thres;
+	hit = diff > sense && std::fabs(sample) > thres;
     return hit;
 }
 
@@ -61,9 +58,6 @@ bool Transient::detectDrums(double sample, double thres, double sense)
 	prevEnergy = totalEnergy;
 
 	diff *= 75; // same story
-	if (cooldown)
-		cooldown -= 1;
-
-	hit = !cooldown && diff > sense && std::fabs(sample) > thres;
+	hit = diff > sense && std::fabs(sample) > thres;
 	return hit;
 }
\ No newline at end of file
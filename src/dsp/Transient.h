@@ -12,13 +12,12 @@ public:
 	Transient() {};
 	~Transient() {};
 
-	void startCooldown();
 	bool detect(int algo, double sample, double thres, double sense);
 	bool detectSimple(double sample, double thres, double sense);
 	bool detectDrums(double sample, double thres, double sense);
 	void clear(double srate);
+	double getEnvelope(int algo) const;
 	
-	int cooldown = 0; // prevent triggers during cooldown (in samples)
 	bool hit = false;
 
 private:
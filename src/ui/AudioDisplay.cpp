@@ -13,13 +13,53 @@
 
 AudioDisplay::AudioDisplay(GATE12AudioProcessor& p) : audioProcessor(p)
 {
-    startTimerHz(60);
+    columns.resize(globals::MAX_PLUG_WIDTH, { 0.f, 0.f }); // columns array size must be >= audio monitor width
+    audioProcessor.monColumns.allocate(globals::DISPLAY_RING_CAPACITY);
 };
 
-void AudioDisplay::timerCallback()
+void AudioDisplay::onFrame()
 {
-    if (isVisible())
-        repaint();
+    const int width = std::max(1, getWidth());
+    int count = 0;
+    MonitorColumn col;
+    while (audioProcessor.monColumns.pop(col)) {
+        columns[writeIndex] = col;
+        writeIndex = (writeIndex + 1) % width;
+        count += 1;
+    }
+
+    // only new columns are rendered, older ones stay in the image
+    if (count > 0 && waveImage.isValid()) {
+        count = std::min(count, width);
+        int first = (writeIndex - count + width) % width;
+        if (first + count <= width) {
+            clearColumns(first, count);
+        }
+        else {
+            clearColumns(first, width - first);
+            clearColumns(0, first + count - width);
+        }
+        Graphics g(waveImage);
+        g.addTransform(AffineTransform::scale(imageScale));
+        for (int i = 0; i < count; ++i)
+            renderColumn(g, (first + i) % width);
+    }
+
+    auto thres = audioProcessor.params.getRawParameterValue("threshold")->load();
+    if (count > 0 || thres != lthreshold) {
+        lthreshold = thres;
+        if (isVisible())
+            repaint();
+    }
+}
+
+void AudioDisplay::onResume()
+{
+    audioProcessor.monColumns.clear();
+    std::fill(columns.begin(), columns.end(), MonitorColumn{ 0.f, 0.f });
+    writeIndex = 0;
+    waveImage = Image();
+    repaint();
 }
 
 void AudioDisplay::resized()
@@ -29,37 +69,80 @@ void AudioDisplay::resized()
         if (safeThis != nullptr)
         safeThis->audioProcessor.monW = safeThis->getWidth();
     });
+    std::fill(columns.begin(), columns.end(), MonitorColumn{ 0.f, 0.f });
+    writeIndex = 0;
+    waveImage = Image();
+}
+
+// renders every column, used when the image is created or the display scale changes
+void AudioDisplay::renderImage(float scale)
+{
+    imageScale = scale;
+    int imgw = (int)std::ceil(getWidth() * scale);
+    int imgh = (int)std::ceil(getHeight() * scale);
+    if (imgw <= 0 || imgh <= 0) {
+        waveImage = Image();
+        return;
+    }
+
+    waveImage = Image(Image::ARGB, imgw, imgh, true);
+    Graphics g(waveImage);
+    g.addTransform(AffineTransform::scale(scale));
+    for (int i = 0; i < getWidth(); ++i)
+        renderColumn(g, i);
+}
+
+void AudioDisplay::clearColumns(int index, int count)
+{
+    int x = (int)std::floor(index * imageScale);
+    int x2 = (int)std::ceil((index + count) * imageScale);
+    waveImage.clear(Rectangle<int>(x, 0, x2 - x, waveImage.getHeight()));
+}
+
+void AudioDisplay::renderColumn(Graphics& g, int index)
+{
+    auto& col = columns[index];
+    const float height = (float)getHeight();
+    auto sample = (float)jlimit(0.0, 1.0, (double)std::max(col.peak, col.hit));
+    if (sample > 0.f) {
+        g.setColour(col.hit > 0.f ? Colour(globals::COLOR_AUDIO) : Colour(0xff7f7f7f));
+        g.fillRect((float)index, height - sample * height, 1.f, sample * height);
+    }
 }
 
 void AudioDisplay::paint(Graphics& g) {
+    FrameScheduler::ScopedPaint paintTimer(*this);
     auto bounds = getLocalBounds();
     g.setColour(Colours::white.withAlpha(0.4f));
     g.drawRect(bounds);
-    g.setColour(Colour(0xff7f7f7f));
     const int width = getWidth();
     const int height = getHeight();
-    const int index = (int)audioProcessor.monpos.load();
 
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (waveImage.isNull() || scale != imageScale)
+        renderImage(scale);
+
+    // the oldest column is at writeIndex, draw from there to the end then wrap around
+    if (waveImage.isValid()) {
+        int split = (int)std::floor(writeIndex * imageScale);
+        int imgw = waveImage.getWidth();
+        int imgh = waveImage.getHeight();
+        g.drawImage(waveImage, 0, 0, width - writeIndex, height, split, 0, imgw - split, imgh);
+        if (writeIndex > 0)
+            g.drawImage(waveImage, width - writeIndex, 0, writeIndex, height, 0, 0, split, imgh);
+    }
+
+    // hit markers overlap neighbour columns so they are drawn on top of the image
+    g.setColour(Colour(globals::COLOR_AUDIO));
     for (int i = 0; i < width; ++i) {
-        double sample = audioProcessor.monSamples[(index + i) % width];
-        if (i == 0) sample = 0.0f; // ignore first pixel, fixes glitching
-        bool hit = sample >= 10.0; // trigger hits are encoded as amplitude +10
-        if (hit)
-            sample -= 10.0;
-        sample = jlimit(0.0,1.0,sample);
-
-        if (sample > 0.0) {
-            g.drawLine((float)i, (float)height,(float)i, (float)(height - sample * height), 1.0f);
-        }
-        if (hit) {
-            g.setColour(Colour(globals::COLOR_AUDIO));
-            g.drawLine((float)i, (float)height,(float)i, (float)(height - sample * height), 1.0f);
+        auto& col = columns[(writeIndex + i) % width];
+        if (col.hit > 0.f) {
+            auto sample = jlimit(0.0, 1.0, (double)std::max(col.peak, col.hit));
             g.fillEllipse((float)(i - 2), (float)(height - sample * height)-2.f,4.f,4.f);
-            g.setColour(Colour(0xff7f7f7f));
         }
     }
 
     auto thres = audioProcessor.params.getRawParameterValue("threshold")->load();
     g.setColour(Colours::white.withAlpha(.4f));
     g.drawLine(0.f, (float)(height - thres * height), (float)width, (float)(height - thres * height));
-}
\ No newline at end of file
+}
@@ -13,20 +13,29 @@
 #include <JuceHeader.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../dsp/Pattern.h"
-#include <deque>
+#include "FrameScheduler.h"
+#include <vector>
 
 class GATE12AudioProcessor;
+struct MonitorColumn;
 
-class AudioDisplay : public juce::Component, private juce::Timer
+class AudioDisplay : public juce::Component, public FrameScheduler::Client
 {
 public:
     AudioDisplay(GATE12AudioProcessor&);
     ~AudioDisplay() override {};
     void resized() override;
-    void timerCallback() override;
+    void onFrame() override;
+    void onResume() override;
     void paint(Graphics& g) override;
+    void renderImage(float scale);
+    void renderColumn(Graphics& g, int index);
+    void clearColumns(int index, int count);
     
-    std::deque<double> audioBuffer;
-    std::deque<bool> hitBuffer; 
+    std::vector<MonitorColumn> columns; // circular buffer of monitor columns read from the processor
+    int writeIndex = 0; // next column to write, also the oldest column displayed
+    Image waveImage; // columns rendered at the same circular positions, blitted in two parts
+    float imageScale = 0.f;
+    float lthreshold = -1.f; // last threshold drawn
     GATE12AudioProcessor& audioProcessor;
 };
\ No newline at end of file
@@ -4,7 +4,6 @@
 BandsWidget::BandsWidget(GATE12AudioProcessorEditor& e)
 	: editor(e)
 {
-	startTimerHz(30);
 	addAndMakeVisible(slopeBtn);
 	slopeBtn.setAlpha(0.f);
 	slopeBtn.onClick = [this]
@@ -16,15 +15,23 @@ BandsWidget::BandsWidget(GATE12AudioProcessorEditor& e)
 }
 BandsWidget::~BandsWidget()
 {
+	editor.audioProcessor.spectrum.stop();
 }
 
-void BandsWidget::timerCallback()
+// the analyzer worker only runs while the bands editor is open
+void BandsWidget::visibilityChanged()
+{
+	if (isVisible())
+		editor.audioProcessor.spectrum.start();
+	else
+		editor.audioProcessor.spectrum.stop();
+}
+
+void BandsWidget::onFrame()
 {
 	if (isShowing()) {
-		if (editor.audioProcessor.showBandsEditor &&
-			editor.audioProcessor.bandsFFTReady.exchange(false, std::memory_order_acquire)) {
-			recalcFFTMags();
-		}
+		if (editor.audioProcessor.showBandsEditor)
+			editor.audioProcessor.spectrum.getLevels(levels);
 
 		repaint();
 	}
@@ -32,31 +39,20 @@ void BandsWidget::timerCallback()
 
 void BandsWidget::drawWaveform(juce::Graphics& g)
 {
-	auto size = fftMagnitudes.size();
+	auto size = levels.size();
 	auto bounds = getLocalBounds().reduced(1).toFloat();
 
 	if (size == 0)
 		return;
 
 	juce::Path waveformPath;
-
-	const float minDB = -90.0f;
-	const float maxDB = 0.0f;
-	const float minFreq = 20.0f;
-	const float maxFreq = 20000.f;
-	const float srate = static_cast<float>(editor.audioProcessor.srate);
-
 	waveformPath.startNewSubPath(bounds.getX(), bounds.getBottom());
 
+	// levels are already aggregated into log spaced columns
+	const float colw = bounds.getWidth() / size;
 	for (size_t i = 0; i < size; ++i) {
-		float freq = (i * srate) / (2.0f * (size - 1));
-		freq = std::max(freq, minFreq);
-		float logPos = std::log10(freq / minFreq) / std::log10(maxFreq / minFreq);
-		float x = bounds.getX() + logPos * bounds.getWidth();
-
-		float magnitudeDB = juce::Decibels::gainToDecibels(fftMagnitudes[i], minDB);
-		float y = juce::jmap(magnitudeDB, minDB, maxDB, bounds.getBottom(), bounds.getY());
-
+		float x = bounds.getX() + (i + 0.5f) * colw;
+		float y = bounds.getBottom() - levels[i] * bounds.getHeight();
 		waveformPath.lineTo(x, y);
 	}
 
@@ -66,33 +62,6 @@ void BandsWidget::drawWaveform(juce::Graphics& g)
 	g.fillPath(waveformPath);
 }
 
-void BandsWidget::recalcFFTMags()
-{
-	auto fftSize = 1 << BANDS_FFT_ORDER;
-	auto writeIndex = editor.audioProcessor.bandsFFTWriteIndex;
-	auto bufferSize = fftData.size();
-	size_t startIndex = (writeIndex + bufferSize - fftSize) % bufferSize;
-
-	if (startIndex + fftSize <= bufferSize) {
-		std::copy_n(&editor.audioProcessor.bandsFFTBuffer[startIndex], fftSize, fftData.data());
-	}
-	else {
-		// Wrap-around copy
-		size_t firstPart = bufferSize - startIndex;
-		std::copy_n(&editor.audioProcessor.bandsFFTBuffer[startIndex], firstPart, fftData.data());
-		std::copy_n(&editor.audioProcessor.bandsFFTBuffer[0], fftSize - firstPart, fftData.data() + firstPart);
-	}
-
-	window.multiplyWithWindowingTable(fftData.data(), fftData.size());
-	fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
-
-	float norm = 1.f / (fftData.size() * 0.5f);
-	for (size_t j = 0; j < fftSize / 2; ++j) {
-	    float mag = fftData[j] * norm;
-	    fftMagnitudes[j] = mag * 0.8f + fftMagnitudes[j] * 0.2f;
-	}
-}
-
 void BandsWidget::parameterChanged(const juce::String& parameterID, float newValue)
 {
 	(void)parameterID;
@@ -101,6 +70,7 @@ void BandsWidget::parameterChanged(const juce::String& parameterID, float newVal
 
 void BandsWidget::paint(Graphics& g)
 {
+	FrameScheduler::ScopedPaint paintTimer(*this);
 	g.fillAll(Colour(COLOR_ACTIVE));
 	auto bounds = getLocalBounds().reduced(1).toFloat();
 	g.setColour(Colour(COLOR_BG));
@@ -249,4 +219,5 @@ void BandsWidget::resized()
 {
 	auto b = getLocalBounds().reduced(1);
 	slopeBtn.setBounds(b.getRight() - 45, 2, 45, 25);
+	editor.audioProcessor.spectrum.setColumns(b.getWidth());
 }
\ No newline at end of file
@@ -2,13 +2,14 @@
 
 #include <JuceHeader.h>
 #include "../Globals.h"
+#include "FrameScheduler.h"
 
 using namespace globals;
 class GATE12AudioProcessorEditor;
 
 class BandsWidget
 	: public juce::Component
-	, private juce::Timer
+	, public FrameScheduler::Client
 	, private juce::AudioProcessorValueTreeState::Listener
 {
 public:
@@ -17,7 +18,8 @@ public:
 	BandsWidget(GATE12AudioProcessorEditor& e);
 	~BandsWidget();
 
-	void timerCallback();
+	void onFrame() override;
+	void visibilityChanged() override;
 	void parameterChanged(const juce::String& parameterID, float newValue) override;
 	void paint(Graphics& g) override;
 	void mouseMove(const MouseEvent& e) override;
@@ -27,14 +29,10 @@ public:
 	void mouseDoubleClick(const MouseEvent& e) override;
 	void resized() override;
 	void drawWaveform(juce::Graphics& g);
-	void recalcFFTMags();
 
 private:
 	GATE12AudioProcessorEditor& editor;
-	juce::dsp::FFT fft{ BANDS_FFT_ORDER };
-	juce::dsp::WindowingFunction<float> window{ 1 << BANDS_FFT_ORDER, juce::dsp::WindowingFunction<float>::blackmanHarris };
-	std::array<float, (1 << BANDS_FFT_ORDER) * 2> fftData{};
-	std::array<float, (1 << BANDS_FFT_ORDER) / 2> fftMagnitudes{};
+	std::vector<float> levels; // spectrum levels per column computed by the processor analyzer
 
 	Rectangle<float> lband;
 	Rectangle<float> rband;
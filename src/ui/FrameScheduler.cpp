@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.cpp
+    Author:  tiagolr
+
+  ==============================================================================
+*/
+
+#include "FrameScheduler.h"
+#include <algorithm>
+#include <iterator>
+
+static constexpr int FPS_STEPS[] = { 60, 30, 20, 15 }; // rates used when paint load is over budget
+
+FrameScheduler::FrameScheduler(juce::Component& e)
+    : editor(e)
+    , vblank(&e, [this] {
+        lastVBlank = juce::Time::getMillisecondCounterHiRes();
+        if (isTimerRunning())
+            stopTimer(); // vblank works, the fallback is not needed
+        fallback = false;
+        tick();
+    })
+{
+    measureStart = juce::Time::getMillisecondCounterHiRes();
+    startTimer(VBLANK_TIMEOUT_MS); // stopped by the first vblank, peers without vblank callbacks switch to the fallback
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    stopTimer();
+    for (auto* client : clients)
+        client->scheduler = nullptr; // clients may outlive the scheduler, ScopedPaint checks for null
+}
+
+void FrameScheduler::addClient(Client* client, int maxFps)
+{
+    client->scheduler = this;
+    client->maxFps = maxFps;
+    clients.push_back(client);
+}
+
+void FrameScheduler::removeClient(Client* client)
+{
+    client->scheduler = nullptr;
+    clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+}
+
+void FrameScheduler::timerCallback()
+{
+    // the vblank attachment needs a peer, wait for the editor to show before giving up on it
+    if (!fallback && !editor.isShowing())
+        return;
+
+    if (juce::Time::getMillisecondCounterHiRes() - lastVBlank > VBLANK_TIMEOUT_MS) {
+        if (!fallback) {
+            fallback = true;
+            startTimerHz(MAX_FPS);
+        }
+        tick();
+    }
+}
+
+void FrameScheduler::tick()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+    auto lfps = fps;
+    updateFrameRate(now);
+
+    // the audio thread kept filling the display rings while hidden or while ticks stalled
+    // (eg. no vblanks on a minimized window), those columns are stale
+    if (fps > 0 && (lfps == 0 || now - lastTick > MEASURE_MILLIS)) {
+        for (auto* client : clients)
+            client->onResume();
+    }
+    lastTick = now;
+
+    for (auto* client : clients) {
+        int rate = std::min(client->maxFps, fps);
+        if (rate <= 0) continue;
+        if (now - client->lastFrame >= 1000.0 / rate - 1.0) { // 1ms tolerance for vblank jitter
+            client->lastFrame = now;
+            client->onFrame();
+        }
+    }
+}
+
+void FrameScheduler::updateFrameRate(double now)
+{
+    // step the frame rate down when painting takes too much of the message thread
+    // and back up when the load is well below budget
+    if (now - measureStart >= MEASURE_MILLIS) {
+        auto load = paintMillis / (now - measureStart);
+        int step = 0;
+        while (FPS_STEPS[step] > budgetFps) ++step;
+        if (load > PAINT_BUDGET && step < (int)std::size(FPS_STEPS) - 1)
+            budgetFps = FPS_STEPS[step + 1];
+        else if (load < PAINT_BUDGET / 3 && step > 0)
+            budgetFps = FPS_STEPS[step - 1];
+        paintMillis = 0.0;
+        measureStart = now;
+    }
+
+    if (!editor.isShowing()) {
+        fps = 0;
+        return;
+    }
+
+    auto peer = editor.getPeer();
+    bool focused = juce::Process::isForegroundProcess()
+        && ((peer != nullptr && peer->isFocused()) || editor.isMouseOverOrDragging(true));
+
+    fps = std::min(budgetFps, focused ? MAX_FPS : BACKGROUND_FPS);
+}
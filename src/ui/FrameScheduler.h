@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.h
+    Author:  tiagolr
+
+    Editor wide frame scheduler, drives every animated component from one tick
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+class FrameScheduler : private juce::Timer
+{
+public:
+    static constexpr int MAX_FPS = 60;
+    static constexpr int BACKGROUND_FPS = 20; // editor not focused or host in background
+    static constexpr double PAINT_BUDGET = 0.25; // max fraction of the message thread spent painting
+    static constexpr double MEASURE_MILLIS = 500.0; // paint load measure window
+    static constexpr int VBLANK_TIMEOUT_MS = 100; // no vblank for this long switches to the fallback timer
+
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        virtual void onFrame() = 0;
+        virtual void onResume() {} // first frame after the editor was hidden, drop what was queued meanwhile
+
+    private:
+        friend class FrameScheduler;
+        FrameScheduler* scheduler = nullptr;
+        int maxFps = MAX_FPS;
+        double lastFrame = 0.0;
+    };
+
+    // measures the paint time of a client, place at the start of paint()
+    class ScopedPaint
+    {
+    public:
+        explicit ScopedPaint(const Client& client)
+            : scheduler(client.scheduler), start(juce::Time::getMillisecondCounterHiRes()) {}
+        ~ScopedPaint()
+        {
+            if (scheduler != nullptr)
+                scheduler->paintMillis += juce::Time::getMillisecondCounterHiRes() - start;
+        }
+
+    private:
+        FrameScheduler* scheduler;
+        double start;
+    };
+
+    FrameScheduler(juce::Component& editor);
+    ~FrameScheduler() override;
+
+    void addClient(Client* client, int maxFps = MAX_FPS);
+    void removeClient(Client* client);
+    int getFrameRate() const { return fps; }
+
+private:
+    void tick();
+    void timerCallback() override;
+    void updateFrameRate(double now);
+
+    juce::Component& editor;
+    juce::VBlankAttachment vblank;
+    std::vector<Client*> clients;
+    double lastVBlank = 0.0;
+    double lastTick = 0.0;
+    bool fallback = false; // timer ticks at MAX_FPS, otherwise it only watches for missing vblanks
+    int fps = 0; // current frame rate cap, zero while the editor is hidden
+    int budgetFps = MAX_FPS; // frame rate cap set by paint load
+    double paintMillis = 0.0; // paint time in the current measure window
+    double measureStart = 0.0;
+};
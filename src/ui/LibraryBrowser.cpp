@@ -0,0 +1,206 @@
+#include "LibraryBrowser.h"
+#include "../PluginProcessor.h"
+
+LibraryBrowser::LibraryBrowser(GATE12AudioProcessor& p)
+    : audioProcessor(p)
+    , thumbnails(*library, THUMB_WIDTH, ROW_HEIGHT - 6)
+{
+    library->addChangeListener(this);
+    thumbnails.onThumbnailReady = [this]() { list.repaint(); };
+
+    addAndMakeVisible(searchBox);
+    searchBox.setTextToShowWhenEmpty("Search", Colour(COLOR_NEUTRAL));
+    searchBox.onTextChange = [this]() { updateResults(); };
+    searchBox.onReturnKey = [this]() { loadSelected(); };
+
+    addAndMakeVisible(sourceMenu);
+    sourceMenu.onChange = [this]() { updateResults(); };
+
+    addAndMakeVisible(slotMenu);
+    for (int i = 0; i < 12; ++i) {
+        slotMenu.addItem("Pattern " + String(i + 1), i + 1);
+    }
+
+    addAndMakeVisible(loadBtn);
+    loadBtn.setButtonText("Load");
+    loadBtn.setComponentID("button");
+    loadBtn.onClick = [this]() { loadSelected(); };
+
+    addAndMakeVisible(folderBtn);
+    folderBtn.setButtonText("Folder");
+    folderBtn.setComponentID("button");
+    folderBtn.onClick = [this]() { library->getFolder().startAsProcess(); };
+
+    addAndMakeVisible(status);
+    status.setColour(Label::textColourId, Colour(COLOR_NEUTRAL));
+
+    addAndMakeVisible(list);
+    list.setModel(this);
+    list.setRowHeight(ROW_HEIGHT);
+    list.setColour(ListBox::backgroundColourId, Colour(COLOR_BG));
+}
+
+LibraryBrowser::~LibraryBrowser()
+{
+    library->removeChangeListener(this);
+    list.setModel(nullptr);
+}
+
+void LibraryBrowser::open()
+{
+    slotMenu.setSelectedId(audioProcessor.pattern->index + 1, dontSendNotification);
+    library->setFolder(audioProcessor.getLibraryFolder());
+    updateSources();
+    updateResults();
+    setVisible(true);
+    toFront(true);
+    searchBox.grabKeyboardFocus();
+}
+
+void LibraryBrowser::mouseDown(const juce::MouseEvent& e)
+{
+    // clicks outside the panel close the browser
+    if (!getLocalBounds().reduced(PLUG_PADDING * 2).contains(e.getPosition()))
+        setVisible(false);
+}
+
+void LibraryBrowser::paint(Graphics& g)
+{
+    g.fillAll(Colour(0xdd000000));
+    auto bounds = getLocalBounds().reduced(PLUG_PADDING * 2);
+    g.setColour(Colour(COLOR_BG));
+    g.fillRect(bounds);
+    g.setColour(Colour(COLOR_NEUTRAL));
+    g.drawRect(bounds);
+}
+
+void LibraryBrowser::resized()
+{
+    auto bounds = getLocalBounds().reduced(PLUG_PADDING * 2).reduced(10);
+    auto row = bounds.removeFromTop(25);
+    folderBtn.setBounds(row.removeFromRight(60));
+    row.removeFromRight(10);
+    sourceMenu.setBounds(row.removeFromRight(150));
+    row.removeFromRight(10);
+    searchBox.setBounds(row);
+
+    bounds.removeFromTop(10);
+    row = bounds.removeFromBottom(25);
+    loadBtn.setBounds(row.removeFromRight(60));
+    row.removeFromRight(10);
+    slotMenu.setBounds(row.removeFromRight(100));
+    status.setBounds(row);
+
+    bounds.removeFromBottom(10);
+    list.setBounds(bounds);
+}
+
+int LibraryBrowser::getNumRows()
+{
+    return (int)results.size();
+}
+
+// only visible rows are painted, entries and thumbnails are fetched on demand
+void LibraryBrowser::paintListBoxItem(int row, Graphics& g, int width, int height, bool selected)
+{
+    if (row < 0 || row >= (int)results.size() || resultsVersion != library->getVersion())
+        return;
+
+    if (selected) {
+        g.setColour(Colour(COLOR_ACTIVE).withAlpha(0.25f));
+        g.fillRect(0, 0, width, height);
+    }
+
+    auto index = results[row];
+    auto thumb = thumbnails.get(index);
+    auto thumbBounds = Rectangle<int>(4, 3, THUMB_WIDTH, height - 6);
+    if (thumb.isValid()) {
+        g.drawImageAt(thumb, thumbBounds.getX(), thumbBounds.getY());
+    }
+    g.setColour(Colour(COLOR_NEUTRAL).withAlpha(0.5f));
+    g.drawRect(thumbBounds);
+
+    auto entry = library->getEntry(index);
+    auto sources = library->getSources();
+    auto text = Rectangle<int>(THUMB_WIDTH + 14, 0, width - THUMB_WIDTH - 18, height);
+    g.setColour(Colours::white);
+    g.setFont(FontOptions(15.f));
+    g.drawText(entry.name, text.removeFromTop(height / 2).withTrimmedTop(2), Justification::bottomLeft);
+    g.setColour(Colour(COLOR_NEUTRAL));
+    g.setFont(FontOptions(13.f));
+    g.drawText(sources[entry.source] + "  " + String(entry.pointCount) + " points", text, Justification::topLeft);
+}
+
+void LibraryBrowser::listBoxItemDoubleClicked(int row, const MouseEvent& e)
+{
+    (void)row;
+    (void)e;
+    loadSelected();
+}
+
+void LibraryBrowser::returnKeyPressed(int row)
+{
+    (void)row;
+    loadSelected();
+}
+
+void LibraryBrowser::changeListenerCallback(ChangeBroadcaster* source)
+{
+    (void)source;
+    updateSources();
+    updateResults();
+}
+
+void LibraryBrowser::updateSources()
+{
+    auto selected = sourceMenu.getText();
+    sourceMenu.clear(dontSendNotification);
+    sourceMenu.addItem("All files", 1);
+    auto sources = library->getSources();
+    auto errors = library->getSourceErrors();
+    for (int i = 0; i < sources.size(); ++i) {
+        sourceMenu.addItem(errors[i].isEmpty() ? sources[i] : sources[i] + " (parse error)", i + 2);
+    }
+    auto idx = sources.indexOf(selected.upToLastOccurrenceOf(" (parse error)", false, false));
+    sourceMenu.setSelectedId(idx >= 0 ? idx + 2 : 1, dontSendNotification);
+}
+
+void LibraryBrowser::updateResults()
+{
+    auto source = sourceMenu.getSelectedId() - 2;
+    results = library->search(searchBox.getText(), source);
+    resultsVersion = library->getVersion();
+    list.updateContent();
+    list.repaint();
+
+    String text = String((int)results.size()) + " of " + String(library->size()) + " patterns";
+    if (library->isScanning())
+        text << ", scanning library";
+
+    // files with errors are left out of the library, the tooltip says why
+    String tooltip;
+    auto sources = library->getSources();
+    auto errors = library->getSourceErrors();
+    int errorCount = 0;
+    for (int i = 0; i < errors.size(); ++i) {
+        if (errors[i].isNotEmpty()) {
+            tooltip << sources[i] << ": " << errors[i] << "\n";
+            ++errorCount;
+        }
+    }
+    if (errorCount > 0)
+        text << ", " << errorCount << (errorCount == 1 ? " file" : " files") << " with errors";
+    status.setText(text, dontSendNotification);
+    status.setTooltip(tooltip.trimEnd());
+}
+
+void LibraryBrowser::loadSelected()
+{
+    auto row = list.getSelectedRow();
+    if (row < 0 && results.size() == 1)
+        row = 0;
+    if (row < 0 || row >= (int)results.size() || resultsVersion != library->getVersion())
+        return;
+
+    audioProcessor.loadLibraryPattern(slotMenu.getSelectedId() - 1, library->getPoints(results[row]));
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../Globals.h"
+#include "../utils/PatternLibrary.h"
+#include "PatternThumbnails.h"
+
+using namespace globals;
+class GATE12AudioProcessor;
+
+// Pattern library browser, lists the library entries with search and source filter
+// and loads the selected pattern into a slot
+class LibraryBrowser : public juce::Component, private juce::ListBoxModel, private juce::ChangeListener {
+public:
+    static constexpr int ROW_HEIGHT = 36;
+    static constexpr int THUMB_WIDTH = 64;
+
+    LibraryBrowser(GATE12AudioProcessor& p);
+    ~LibraryBrowser() override;
+
+    void open();
+    void paint(Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent& e) override;
+
+private:
+    int getNumRows() override;
+    void paintListBoxItem(int row, Graphics& g, int width, int height, bool selected) override;
+    void listBoxItemDoubleClicked(int row, const MouseEvent& e) override;
+    void returnKeyPressed(int row) override;
+    void changeListenerCallback(ChangeBroadcaster* source) override;
+
+    void updateSources();
+    void updateResults();
+    void loadSelected();
+
+    GATE12AudioProcessor& audioProcessor;
+    juce::SharedResourcePointer<PatternLibrary> library;
+    PatternThumbnails thumbnails;
+    std::vector<int> results; // library entry indexes matching the search
+    juce::uint64 resultsVersion = 0; // library version of the results
+
+    TextEditor searchBox;
+    ComboBox sourceMenu;
+    ComboBox slotMenu;
+    ListBox list;
+    TextButton loadBtn;
+    TextButton folderBtn;
+    Label status;
+};
@@ -249,8 +249,19 @@ void Multiselect::makeSelection(const MouseEvent& e, Point<int>selectionStart, P
     );
 
 
-    auto points = audioProcessor.viewPattern->points;
-    for (size_t i = 0; i < points.size(); ++i) {
+    std::unordered_set<uint64_t> selectedIds;
+    for (auto& p : selectionPoints) {
+        selectedIds.insert(p.id);
+    }
+
+    // only points inside the selection x range are tested
+    auto& points = audioProcessor.viewPattern->points;
+    auto range = audioProcessor.viewPattern->getPointsInRange(
+        (selArea.getX() - winx - 1) / (double)winw,
+        (selArea.getRight() - winx + 1) / (double)winw
+    );
+    bool removed = false;
+    for (int i = range.first; i < range.second; ++i) {
         auto& p = points[i];
         auto id = p.id;
         int x = (int)(p.x * winw + winx);
@@ -259,23 +270,26 @@ void Multiselect::makeSelection(const MouseEvent& e, Point<int>selectionStart, P
         if (selArea.contains(x, y)) {
             // if ctrl is down remove point from selection
             if (e.mods.isCtrlDown()) {
-                selectionPoints.erase(
-                    std::remove_if(
-                        selectionPoints.begin(),
-                        selectionPoints.end(),
-                        [id](const SelPoint& p) { return p.id == id; }
-                    ),
-                    selectionPoints.end()
-                );
+                removed |= selectedIds.erase(id) > 0;
             }
             // if point is not on selection, add it
-            else if (!std::any_of(selectionPoints.begin(), selectionPoints.end(),
-                [id](const SelPoint& p) { return p.id == id; })) {
+            else if (selectedIds.insert(id).second) {
                 selectionPoints.push_back({ p.id, p.x, p.y, 0.0, 0.0 });
             }
         }
     }
 
+    if (removed) {
+        selectionPoints.erase(
+            std::remove_if(
+                selectionPoints.begin(),
+                selectionPoints.end(),
+                [&selectedIds](const SelPoint& p) { return selectedIds.count(p.id) == 0; }
+            ),
+            selectionPoints.end()
+        );
+    }
+
     if (selectionPoints.size() > 0) {
         recalcSelectionArea();
     }
@@ -284,13 +298,14 @@ void Multiselect::makeSelection(const MouseEvent& e, Point<int>selectionStart, P
 void Multiselect::recalcSelectionArea()
 {
     // the pattern may have changed, first update the selected points
+    std::unordered_set<uint64_t> selectedIds;
+    for (auto& p : selectionPoints) {
+        selectedIds.insert(p.id);
+    }
     std::vector<SelPoint> selPoints;
-    std::vector<PPoint> patPoints = audioProcessor.viewPattern->points;
-    for (auto i = patPoints.begin(); i < patPoints.end(); ++i) {
-        for (auto j = selectionPoints.begin(); j < selectionPoints.end(); ++j) {
-            if (i->id == j->id) {
-                selPoints.push_back({ i->id, i->x, i->y, 0.0, 0.0 });
-            }
+    for (auto& p : audioProcessor.viewPattern->points) {
+        if (selectedIds.count(p.id)) {
+            selPoints.push_back({ p.id, p.x, p.y, 0.0, 0.0 });
         }
     }
     selectionPoints = selPoints;
@@ -536,14 +551,11 @@ void Multiselect::updatePointsToSelection()
         p.y = newpos.y;
 
         // update pattern point
-        auto& points = audioProcessor.viewPattern->points;
-        for (size_t j = 0; j < points.size(); ++j) {
-            auto& pp = points[j];
-            if (pp.id == p.id) {
-                pp.x = newpos.x;
-                pp.y = newpos.y;
-                break;
-            }
+        auto idx = audioProcessor.viewPattern->getPointIndex(p.id);
+        if (idx >= 0) {
+            auto& pp = audioProcessor.viewPattern->points[idx];
+            pp.x = newpos.x;
+            pp.y = newpos.y;
         }
     }
 
@@ -553,16 +565,11 @@ void Multiselect::updatePointsToSelection()
 
 void Multiselect::deleteSelectedPoints()
 {
-    for (size_t i = 0; i < selectionPoints.size(); ++i) {
-        auto& p = selectionPoints[i];
-        auto& points = audioProcessor.viewPattern->points;
-        for (size_t j = 0; j < points.size(); ++j) {
-            if (points[j].id == p.id) {
-                audioProcessor.viewPattern->removePoint(static_cast<int>(j));
-                break;
-            }
-        }
+    std::unordered_set<uint64_t> ids;
+    for (auto& p : selectionPoints) {
+        ids.insert(p.id);
     }
+    audioProcessor.viewPattern->removePoints(ids);
     clearSelection();
     audioProcessor.viewPattern->buildSegments();
 }
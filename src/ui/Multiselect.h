@@ -10,6 +10,7 @@ Author:  tiagolr
 
 #include <JuceHeader.h>
 #include <iostream>
+#include <unordered_set>
 #include "../Globals.h"
 
 using namespace globals;
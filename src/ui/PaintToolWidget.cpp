@@ -35,8 +35,6 @@ PaintToolWidget::PaintToolWidget(GATE12AudioProcessor& p) : audioProcessor(p)
         audioProcessor.paintPage = page;
         MessageManager::callAsync([this]() { audioProcessor.sendChangeMessage(); });
     };
-
-    startTimerHz(60);
 }
 
 void PaintToolWidget::resized()
@@ -62,7 +60,7 @@ void PaintToolWidget::toggleUIComponents()
     paintPageLabel.setText(String(firstPaintPat) + "-" + String(firstPaintPat+7), dontSendNotification);
 }
 
-void PaintToolWidget::timerCallback()
+void PaintToolWidget::onFrame()
 {
     if (isVisible())
         repaint();
@@ -70,6 +68,7 @@ void PaintToolWidget::timerCallback()
 
 void PaintToolWidget::paint(Graphics& g)
 {
+    FrameScheduler::ScopedPaint paintTimer(*this);
     auto rects = getPatRects();
     for (int i = 0; i < (int)rects.size(); ++i) {
         int pati = i + audioProcessor.paintPage * 8;
@@ -2,11 +2,12 @@
 
 #include <JuceHeader.h>
 #include "../Globals.h"
+#include "FrameScheduler.h"
 
 using namespace globals;
 class GATE12AudioProcessor;
 
-class PaintToolWidget : public juce::Component, private juce::Timer {
+class PaintToolWidget : public juce::Component, public FrameScheduler::Client {
 public:
     PaintToolWidget(GATE12AudioProcessor& p);
     ~PaintToolWidget() override {}
@@ -17,7 +18,7 @@ public:
     Label paintPageLabel;
 
     void toggleUIComponents();
-    void timerCallback() override;
+    void onFrame() override;
     void paint(Graphics& g) override;
     void resized() override;
     void drawPattern(Graphics& g, Rectangle<int> bounds, int index, Colour color);
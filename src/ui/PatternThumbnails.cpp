@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    PatternThumbnails.cpp
+    Author:  tiagolr
+
+  ==============================================================================
+*/
+
+#include "PatternThumbnails.h"
+#include "../Globals.h"
+
+PatternThumbnails::PatternThumbnails(PatternLibrary& lib, int w, int h)
+    : juce::Thread("PatternThumbnails")
+    , library(lib)
+    , width(w)
+    , height(h)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+PatternThumbnails::~PatternThumbnails()
+{
+    signalThreadShouldExit();
+    wakeUp.signal();
+    stopThread(1000);
+    cancelPendingUpdate();
+}
+
+juce::Image PatternThumbnails::get(int index)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    if (cacheVersion != library.getVersion()) {
+        cache.clear();
+        lru.clear();
+        pending.clear();
+        pendingSet.clear();
+        cacheVersion = library.getVersion();
+    }
+
+    auto it = cache.find(index);
+    if (it != cache.end()) {
+        lru.splice(lru.begin(), lru, it->second.second);
+        return it->second.first;
+    }
+
+    if (pendingSet.insert(index).second) {
+        pending.push_front(index);
+        if ((int)pending.size() > MAX_PENDING) {
+            pendingSet.erase(pending.back());
+            pending.pop_back();
+        }
+        wakeUp.signal();
+    }
+    return {};
+}
+
+void PatternThumbnails::clear()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    cache.clear();
+    lru.clear();
+    pending.clear();
+    pendingSet.clear();
+}
+
+void PatternThumbnails::run()
+{
+    while (!threadShouldExit()) {
+        int index = -1;
+        juce::uint64 version = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!pending.empty()) {
+                index = pending.front();
+                pending.pop_front();
+                version = cacheVersion;
+            }
+        }
+
+        if (index < 0) {
+            wakeUp.wait(100);
+            continue;
+        }
+
+        auto image = render(index);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            pendingSet.erase(index);
+            if (version != cacheVersion)
+                continue; // library reloaded while rendering
+
+            lru.push_front(index);
+            cache[index] = { image, lru.begin() };
+            if ((int)cache.size() > CAPACITY) {
+                cache.erase(lru.back());
+                lru.pop_back();
+            }
+        }
+
+        triggerAsyncUpdate(); // coalesces repaints when many thumbnails finish at once
+    }
+}
+
+void PatternThumbnails::handleAsyncUpdate()
+{
+    if (onThumbnailReady)
+        onThumbnailReady();
+}
+
+// draws the pattern curve into a software image, safe to use outside the message thread
+juce::Image PatternThumbnails::render(int index)
+{
+    Pattern pat(-1);
+    pat.setPoints(library.getPoints(index));
+    pat.buildSegments();
+
+    juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+
+    juce::Path path;
+    path.startNewSubPath(0.f, (float)(pat.get_y_at(0.0) * (height - 2) + 1));
+    for (int x = 1; x <= width; ++x) {
+        auto y = pat.get_y_at((double)x / width);
+        path.lineTo((float)x, (float)(y * (height - 2) + 1));
+    }
+
+    juce::Path fill(path);
+    fill.lineTo((float)width, (float)height);
+    fill.lineTo(0.f, (float)height);
+    fill.closeSubPath();
+
+    g.setColour(juce::Colour(globals::COLOR_ACTIVE).withAlpha(0.25f));
+    g.fillPath(fill);
+    g.setColour(juce::Colour(globals::COLOR_ACTIVE));
+    g.strokePath(path, juce::PathStrokeType(1.f));
+    return image;
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    PatternThumbnails.h
+    Author:  tiagolr
+
+    Thumbnails of library patterns, rendered on a background thread and cached
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include "../utils/PatternLibrary.h"
+
+class PatternThumbnails : private juce::Thread, private juce::AsyncUpdater
+{
+public:
+    static constexpr int CAPACITY = 512; // max cached thumbnails
+    static constexpr int MAX_PENDING = 64; // older requests are dropped, usually rows scrolled out of view
+
+    PatternThumbnails(PatternLibrary& library, int width, int height);
+    ~PatternThumbnails() override;
+
+    // returns the cached thumbnail or an invalid image and queues it for rendering
+    juce::Image get(int index);
+    void clear();
+
+    std::function<void()> onThumbnailReady; // called on the message thread
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+    juce::Image render(int index);
+
+    PatternLibrary& library;
+    int width;
+    int height;
+
+    std::mutex mtx;
+    std::deque<int> pending; // newest requests first
+    std::unordered_set<int> pendingSet;
+    std::list<int> lru; // most recently used first
+    std::unordered_map<int, std::pair<juce::Image, std::list<int>::iterator>> cache;
+    juce::uint64 cacheVersion = 0; // library version of the cached thumbnails
+    juce::WaitableEvent wakeUp;
+};
@@ -1,5 +1,6 @@
 #include "Sequencer.h"
 #include "../PluginProcessor.h"
+#include "../utils/Xoshiro.h"
 
 Sequencer::Sequencer(GATE12AudioProcessor& p) : audioProcessor(p)
 {
@@ -413,14 +414,14 @@ void Sequencer::open()
     isOpen = true;
     backup = audioProcessor.pattern->points;
     patternIdx = audioProcessor.pattern->index;
+    publishedPattern = nullptr;
     build();
-    audioProcessor.pattern->points = pat->points;
-    audioProcessor.pattern->buildSegments();
 }
 
 void Sequencer::close()
 {
     isOpen = false;
+    publishedPattern = nullptr;
     if (audioProcessor.pattern->index != patternIdx)
         return;
 
@@ -467,24 +468,79 @@ void Sequencer::apply()
 
 void Sequencer::build()
 {
-    pat->clear();
-
+    // regenerate only the cells that changed since the last build
+    std::vector<CellPoints> cache;
+    cache.reserve(cells.size());
+    std::vector<bool> reused(cellPoints.size(), false);
+    std::vector<PPoint> added;
+    size_t next = 0;
     for (auto& cell : cells) {
-        auto seg = buildSeg(cell);
-        for (auto& pt : seg) {
-            auto x = pt.x;
-            if (x < 0.0) x += 1.0;
-            if (x > 1.0) x -= 1.0;
-            pat->insertPoint(x, pt.y, pt.tension, pt.type, false);
+        uint64_t paintVersion = cell.shape == SPTool
+            ? audioProcessor.getPaintPatern(cell.ptool)->curveVersion.load()
+            : 0;
+
+        auto it = std::find_if(cellPoints.begin() + next, cellPoints.end(), [&](const CellPoints& c) {
+            return c.cell == cell && c.paintVersion == paintVersion;
+        });
+        if (it != cellPoints.end()) {
+            next = (size_t)std::distance(cellPoints.begin(), it);
+            reused[next++] = true;
+            cache.push_back(std::move(*it));
+            continue;
+        }
+
+        auto pts = buildSeg(cell);
+        for (auto& pt : pts) {
+            if (pt.x < 0.0) pt.x += 1.0;
+            if (pt.x > 1.0) pt.x -= 1.0;
+            pt.id = Pattern::newPointID();
+        }
+        std::stable_sort(pts.begin(), pts.end(), [](const PPoint& a, const PPoint& b) { return a.x < b.x; });
+        added.insert(added.end(), pts.begin(), pts.end());
+        cache.push_back({ cell, paintVersion, std::move(pts) });
+    }
+
+    std::unordered_set<uint64_t> removed;
+    for (size_t i = 0; i < cellPoints.size(); ++i) {
+        if (!reused[i]) {
+            for (auto& pt : cellPoints[i].points)
+                removed.insert(pt.id);
         }
     }
+    cellPoints = std::move(cache);
 
-    pat->sortPoints();
-    //pat->points = removeCollinearPoints(pat->points);
-    auto& pattern = audioProcessor.pattern;
-    pattern->points = pat->points;
-    pattern->buildSegments();
+    auto cmp = [](const PPoint& a, const PPoint& b) { return a.x < b.x; };
+    if (publishedPattern != audioProcessor.pattern) {
+        // first build on this pattern, every cell is merged
+        built.clear();
+        for (auto& c : cellPoints) {
+            built.insert(built.end(), c.points.begin(), c.points.end());
+        }
+        std::stable_sort(built.begin(), built.end(), cmp);
+    }
+    else if (added.empty() && removed.empty()) {
+        return;
+    }
+    else {
+        // splice, points of the changed cells are removed and the new ones merged in, O(n + k log k)
+        if (!removed.empty()) {
+            built.erase(std::remove_if(built.begin(), built.end(),
+                [&removed](const PPoint& p) { return removed.count(p.id) > 0; }),
+                built.end());
+        }
+        std::stable_sort(added.begin(), added.end(), cmp);
+        auto mid = built.size();
+        built.insert(built.end(), added.begin(), added.end());
+        std::inplace_merge(built.begin(), built.begin() + mid, built.end(), cmp);
+    }
+    //built = removeCollinearPoints(built);
 
+    // points and segments are published together, the audio thread sees a single segments swap
+    pat->points = built;
+    publishedPattern = audioProcessor.pattern;
+    auto pts = built;
+    auto segs = Pattern::makeSegments(built);
+    publishedPattern->publish(pts, segs);
 }
 
 /*
@@ -621,8 +677,17 @@ void Sequencer::sortCells()
         });
 }
 
+// randomizes with a new sequencer seed and the processor options
 void Sequencer::randomize(SeqEditMode mode, double min, double max)
 {
+    randomize(mode, min, max, audioProcessor.newSequencerSeed(), audioProcessor.randomOptions);
+}
+
+// deterministic for the same cells, seed and options
+// cells are edited in place, build() then rebuilds the pattern and its segments like any other edit
+void Sequencer::randomize(SeqEditMode mode, double min, double max, uint64_t seed, const RandomOptions& options)
+{
+    Xoshiro rng(seed);
     bool snap = audioProcessor.params.getRawParameterValue("snap")->load() == 1.0f;
     int grid = audioProcessor.getCurrentGrid();
     auto snapy = grid % 6 == 0 ? 12.0 : 16.0;
@@ -646,9 +711,13 @@ void Sequencer::randomize(SeqEditMode mode, double min, double max)
             rmin = std::min(rmax - (max - min) * rmax, rmin);
         }
 
-        double random = (rand() / (double)RAND_MAX);
+        double random = rng.nextDouble();
+        bool selected = rng.nextBool(options.probability);
+        bool filled = rng.nextBool(options.density);
         double value = rmin + (rmax - rmin) * random;
         bool flag = random <= (rmax - rmin) / 2.0 + rmin; // the slider is a double range, arrange it so that when the range is full the prob is 50%
+        if (!selected)
+            continue;
 
         if (snap) {
             value = std::round(value * snapy) / snapy;
@@ -666,6 +735,7 @@ void Sequencer::randomize(SeqEditMode mode, double min, double max)
         else if (mode == EditMax) cell.miny = std::min(1.0 - value, cell.maxy);
         else if (mode == EditMin) cell.maxy = std::max(1.0 - value, cell.miny);
         else if (mode == EditInvertX) cell.invertx = flag;
+        else if (mode == EditSilence && cell.lshape != SSilence && cell.lshape != SNone) cell.shape = filled ? cell.lshape : SSilence;
     }
 
     build();
@@ -683,22 +753,14 @@ void Sequencer::createUndo(std::vector<Cell> snap)
     if (compareCells(snap, cells)) {
         return; // nothing to undo
     }
-    if (undoStack.size() > globals::MAX_UNDO) {
-        undoStack.erase(undoStack.begin());
-    }
-    undoStack.push_back(snap);
-    redoStack.clear();
+    history.push(snap);
     MessageManager::callAsync([this]() { audioProcessor.sendChangeMessage(); }); // repaint undo/redo buttons
 }
 void Sequencer::undo()
 {
-    if (undoStack.empty())
+    if (!history.undo(cells))
         return;
 
-    redoStack.push_back(cells);
-    cells = undoStack.back();
-    undoStack.pop_back();
-
     build();
     MessageManager::callAsync([this]() {
         audioProcessor.sendChangeMessage(); // repaint undo/redo buttons
@@ -707,13 +769,9 @@ void Sequencer::undo()
 
 void Sequencer::redo()
 {
-    if (redoStack.empty())
+    if (!history.redo(cells))
         return;
 
-    undoStack.push_back(cells);
-    cells = redoStack.back();
-    redoStack.pop_back();
-
     build();
     MessageManager::callAsync([this]() {
         audioProcessor.sendChangeMessage(); // repaint undo/redo buttons
@@ -722,8 +780,7 @@ void Sequencer::redo()
 
 void Sequencer::clearUndo()
 {
-    undoStack.clear();
-    redoStack.clear();
+    history.clear();
     MessageManager::callAsync([this]() {
         audioProcessor.sendChangeMessage(); // repaint undo/redo buttons
         });
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../Globals.h"
 #include "../dsp/Pattern.h"
+#include "../utils/UndoHistory.h"
 #include "algorithm"
 
 using namespace globals;
@@ -43,6 +44,19 @@ struct Cell {
     double tenatt; // attack tension
     double tenrel; // release tension
     double skew;
+
+    bool operator==(const Cell& o) const {
+        return shape == o.shape && lshape == o.lshape && ptool == o.ptool && invertx == o.invertx
+            && minx == o.minx && maxx == o.maxx && miny == o.miny && maxy == o.maxy
+            && tenatt == o.tenatt && tenrel == o.tenrel && skew == o.skew;
+    }
+};
+
+// points generated for a cell, reused by build() while the cell is unchanged
+struct CellPoints {
+    Cell cell;
+    uint64_t paintVersion; // curve version of the paint pattern used by SPTool cells
+    std::vector<PPoint> points; // sorted and wrapped to 0..1
 };
 
 class Sequencer {
@@ -88,10 +102,10 @@ public:
     void sortCells();
 
     void randomize(SeqEditMode mode, double min, double max);
+    void randomize(SeqEditMode mode, double min, double max, uint64_t seed, const RandomOptions& options);
     void clear(SeqEditMode mode);
 
-    std::vector<std::vector<Cell>> undoStack;
-    std::vector<std::vector<Cell>> redoStack;
+    UndoHistory<Cell> history;
     void clearUndo();
     void createUndo(std::vector<Cell> snapshot);
     void undo();
@@ -109,6 +123,9 @@ private:
 
     std::vector<Cell> snapshot;
     Pattern* pat;
+    std::vector<CellPoints> cellPoints; // cache of the last build, one entry per cell
+    std::vector<PPoint> built; // sorted points of the last build, changed cells are spliced in
+    Pattern* publishedPattern = nullptr; // audio pattern that holds the last build
     Pattern* tmp; // temp pattern used for painting
     int winx = 0;
     int winy = 0;
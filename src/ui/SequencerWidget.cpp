@@ -66,17 +66,26 @@ SequencerWidget::SequencerWidget(GATE12AudioProcessor& p) : audioProcessor(p)
 	randomMenuBtn.onClick = [this]() {
 		PopupMenu menu;
 		menu.addItem(1, "Random All");
+		menu.addItem(2, "Random silence");
 		Point<int> pos = localPointToGlobal(randomMenuBtn.getBounds().getTopRight());
 		menu.showMenuAsync(PopupMenu::Options().withTargetScreenArea({ pos.getX(), pos.getY(), 1, 1 }), [this](int result) {
 			if (result == 1) {
+				// one seed for all passes so the whole result can be regenerated
+				auto seed = audioProcessor.newSequencerSeed();
+				auto& options = audioProcessor.randomOptions;
 				auto snap = audioProcessor.sequencer->cells;
 				audioProcessor.sequencer->clear(EditMax);
 				audioProcessor.sequencer->clear(EditMin);
-				audioProcessor.sequencer->randomize(EditMax, randomMin, randomMax);
-				audioProcessor.sequencer->randomize(EditMin, randomMin, randomMax);
-				audioProcessor.sequencer->randomize(EditTenAtt, randomMin, randomMax);
-				audioProcessor.sequencer->randomize(EditTenRel, randomMin, randomMax);
-				audioProcessor.sequencer->randomize(EditInvertX, randomMin, randomMax);
+				audioProcessor.sequencer->randomize(EditMax, randomMin, randomMax, seed, options);
+				audioProcessor.sequencer->randomize(EditMin, randomMin, randomMax, seed + 1, options);
+				audioProcessor.sequencer->randomize(EditTenAtt, randomMin, randomMax, seed + 2, options);
+				audioProcessor.sequencer->randomize(EditTenRel, randomMin, randomMax, seed + 3, options);
+				audioProcessor.sequencer->randomize(EditInvertX, randomMin, randomMax, seed + 4, options);
+			}
+			else if (result == 2) {
+				auto snap = audioProcessor.sequencer->cells;
+				audioProcessor.sequencer->randomize(EditSilence, randomMin, randomMax);
+				audioProcessor.sequencer->createUndo(snap);
 			}
 			});
 		};
@@ -2,6 +2,89 @@
 #include "../PluginProcessor.h"
 #include "../Globals.h"
 
+static const double RETRIGGER_IGNORE[] = { 0.5, 0.75, 0.9, 0.98, 1.0 };
+static const double RETRIGGER_COOLDOWN_MILLIS[] = { 0.0, 10.0, 25.0, 50.0, 100.0 };
+static const double RETRIGGER_COOLDOWN_BEATS[] = { 1. / 16., 1. / 8., 1. / 4., 1. / 2. }; // 1/64 to 1/8 in quarter notes
+static const char* RETRIGGER_COOLDOWN_NOTES[] = { "1/64", "1/32", "1/16", "1/8" };
+
+static const double RANDOM_DENSITY[] = { 1.0, 0.75, 0.5, 0.25 };
+static const double RANDOM_SWING[] = { 0.0, 0.33, 0.66, 1.0 };
+static const double RANDOM_PROBABILITY[] = { 1.0, 0.75, 0.5, 0.25 };
+static const double RANDOM_TENSION[] = { 0.0, 0.25, 0.5, 1.0 };
+
+static PopupMenu makeRetriggerMenu(RetriggerPolicy& policy, int id)
+{
+	PopupMenu menu;
+	menu.addItem(id + 0, "Retrigger", true, policy.mode == RetriggerMode::Retrigger);
+	menu.addItem(id + 1, "Ignore while playing", true, policy.mode == RetriggerMode::IgnoreUntil);
+	menu.addItem(id + 2, "Crossfade", true, policy.mode == RetriggerMode::Crossfade);
+	menu.addItem(id + 3, "Queue next", true, policy.mode == RetriggerMode::QueueNext);
+
+	PopupMenu ignore;
+	for (int i = 0; i < (int)std::size(RETRIGGER_IGNORE); ++i) {
+		ignore.addItem(id + 10 + i, String((int)std::round(RETRIGGER_IGNORE[i] * 100)) + "%", true, policy.ignoreUntil == RETRIGGER_IGNORE[i]);
+	}
+
+	PopupMenu cooldown;
+	for (int i = 0; i < (int)std::size(RETRIGGER_COOLDOWN_MILLIS); ++i) {
+		auto ms = RETRIGGER_COOLDOWN_MILLIS[i];
+		cooldown.addItem(id + 20 + i, ms == 0.0 ? String("Off") : String((int)ms) + " ms", true, policy.cooldownBeats == 0.0 && policy.cooldownMillis == ms);
+	}
+	cooldown.addSeparator();
+	for (int i = 0; i < (int)std::size(RETRIGGER_COOLDOWN_BEATS); ++i) {
+		cooldown.addItem(id + 30 + i, RETRIGGER_COOLDOWN_NOTES[i], true, policy.cooldownBeats == RETRIGGER_COOLDOWN_BEATS[i]);
+	}
+
+	menu.addSeparator();
+	menu.addSubMenu("Ignore until", ignore);
+	menu.addSubMenu("Cooldown", cooldown);
+	return menu;
+}
+
+static void onRetriggerMenu(RetriggerPolicy& policy, int result)
+{
+	if (result < 10) {
+		policy.mode = result;
+	}
+	else if (result < 20) {
+		policy.ignoreUntil = RETRIGGER_IGNORE[result - 10];
+	}
+	else if (result < 30) {
+		policy.cooldownMillis = RETRIGGER_COOLDOWN_MILLIS[result - 20];
+		policy.cooldownBeats = 0.0;
+	}
+	else {
+		policy.cooldownBeats = RETRIGGER_COOLDOWN_BEATS[result - 30];
+	}
+}
+
+static PopupMenu makeRandomMenu(const RandomOptions& options, int id)
+{
+	auto percent = [](double value) { return String((int)std::round(value * 100)) + "%"; };
+	PopupMenu density, swing, probability, tension;
+	for (int i = 0; i < 4; ++i) {
+		density.addItem(id + i, percent(RANDOM_DENSITY[i]), true, options.density == RANDOM_DENSITY[i]);
+		swing.addItem(id + 10 + i, RANDOM_SWING[i] == 0.0 ? String("Off") : percent(RANDOM_SWING[i]), true, options.swing == RANDOM_SWING[i]);
+		probability.addItem(id + 20 + i, percent(RANDOM_PROBABILITY[i]), true, options.probability == RANDOM_PROBABILITY[i]);
+		tension.addItem(id + 30 + i, RANDOM_TENSION[i] == 0.0 ? String("Off") : percent(RANDOM_TENSION[i]), true, options.tension == RANDOM_TENSION[i]);
+	}
+
+	PopupMenu menu;
+	menu.addSubMenu("Density", density);
+	menu.addSubMenu("Swing", swing);
+	menu.addSubMenu("Step probability", probability);
+	menu.addSubMenu("Tension", tension);
+	return menu;
+}
+
+static void onRandomMenu(RandomOptions& options, int result)
+{
+	if (result < 10) options.density = RANDOM_DENSITY[result];
+	else if (result < 20) options.swing = RANDOM_SWING[result - 10];
+	else if (result < 30) options.probability = RANDOM_PROBABILITY[result - 20];
+	else options.tension = RANDOM_TENSION[result - 30];
+}
+
 void SettingsButton::paint(Graphics& g)
 {
 	auto r = 1.5f;
@@ -38,7 +121,13 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 	triggerChn.addItem(27, "Any", true, audioProcessor.triggerChn == 16);
 
 	PopupMenu audioTrigger;
-	audioTrigger.addItem(32, "Ignore hits while playing", true, audioProcessor.audioIgnoreHitsWhilePlaying);
+	audioTrigger.addSubMenu("Retrigger", makeRetriggerMenu(audioProcessor.audioRetrigger, 3000));
+
+	PopupMenu envDepth;
+	envDepth.addItem(33, "Off", true, audioProcessor.envDepthMode == 0);
+	envDepth.addItem(34, "Follow", true, audioProcessor.envDepthMode == 1);
+	envDepth.addItem(35, "Inverted", true, audioProcessor.envDepthMode == 2);
+	audioTrigger.addSubMenu("Envelope depth", envDepth);
 
 	PopupMenu CC;
 	CC.addItem(300, "Off", true, audioProcessor.outputCC == 0);
@@ -66,11 +155,29 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 		audioOutputMIDI.addItem(500+i, midiNoteToName(i-1), true, audioProcessor.outputATMIDI == i);
 	}
 
+	PopupMenu audioOutputMIDILength;
+	for (int i = 0; i < (int)std::size(GATE12AudioProcessor::ATMIDI_NOTE_LENGTHS); ++i) {
+		auto length = GATE12AudioProcessor::ATMIDI_NOTE_LENGTHS[i];
+		audioOutputMIDILength.addItem(710 + i, String(length) + " ms", true, audioProcessor.outputATMIDILength == length);
+	}
+
+	PopupMenu hitLog;
+	hitLog.addItem(720, "Record hits", true, audioProcessor.hitLog.isEnabled());
+	hitLog.addItem(721, "Export (samples)");
+	hitLog.addItem(722, "Export (PPQ)");
+	hitLog.addItem(723, "Clear");
+	if (auto dropped = audioProcessor.hitLog.getDroppedCount()) {
+		hitLog.addSeparator();
+		hitLog.addItem(724, String(dropped) + " hits dropped, log was full", false);
+	}
+
 	PopupMenu output;
 	output.addItem(700, "CV", true, audioProcessor.outputCV);
 	output.addSubMenu("CC", CC);
 	output.addSubMenu("CC Channel", CCChan);
 	output.addSubMenu("Audio Trig. MIDI", audioOutputMIDI);
+	output.addSubMenu("Audio Trig. MIDI length", audioOutputMIDILength);
+	output.addSubMenu("Audio Trig. hit log", hitLog);
 	output.addSeparator();
 	output.addItem(701, "Bipolar CC", true, audioProcessor.bipolarCC);
 
@@ -83,18 +190,22 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 	options.addSubMenu("Anti-click", antiClick);
 	options.addSubMenu("Output", output);
 	options.addSubMenu("MIDI trigger chn", midiTriggerChn);
+	options.addSubMenu("MIDI retrigger", makeRetriggerMenu(audioProcessor.midiRetrigger, 3100));
 	options.addSubMenu("Pattern select chn", triggerChn);
 	options.addSubMenu("Audio trigger", audioTrigger);
 	options.addItem(9999, "Draw sidechain", true, audioProcessor.drawSidechain);
 	options.addSeparator();
 	options.addItem(30, "Dual smooth", true, audioProcessor.dualSmooth);
 	options.addItem(31, "Dual tension", true, audioProcessor.dualTension);
+	options.addSeparator();
+	options.addSubMenu("Randomize", makeRandomMenu(audioProcessor.randomOptions, 3200));
 
 
 	PopupMenu load;
 	load.addItem(100, "Sine", audioProcessor.uimode != UIMode::Seq);
 	load.addItem(101, "Triangle", audioProcessor.uimode != UIMode::Seq);
 	load.addItem(102, "Random", audioProcessor.uimode != UIMode::Seq);
+	load.addItem(103, "Random again", audioProcessor.uimode != UIMode::Seq && audioProcessor.patternSeed != 0);
 	load.addSeparator();
 	load.addItem(109, "Init");
 
@@ -172,6 +283,7 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 	menu.addItem(52, audioProcessor.uimode == UIMode::Seq ? "Reset" : "Clear");
 	menu.addSeparator();
 	menu.addSubMenu("Load", load);
+	menu.addItem(1005, "Pattern library");
 	menu.addItem(1000, "About");
 	menu.showMenuAsync(PopupMenu::Options()
 		.withTargetScreenArea({menuPos.getX() -110, menuPos.getY(), 1, 1}),
@@ -198,10 +310,17 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 					toggleUIComponents();
 				});
 			}
-			else if (result == 32) {
-				MessageManager::callAsync([this]() {
-					audioProcessor.audioIgnoreHitsWhilePlaying = !audioProcessor.audioIgnoreHitsWhilePlaying;
-				});
+			else if (result >= 3000 && result < 3100) {
+				onRetriggerMenu(audioProcessor.audioRetrigger, result - 3000);
+			}
+			else if (result >= 3100 && result < 3200) {
+				onRetriggerMenu(audioProcessor.midiRetrigger, result - 3100);
+			}
+			else if (result >= 3200 && result < 3300) {
+				onRandomMenu(audioProcessor.randomOptions, result - 3200);
+			}
+			else if (result >= 33 && result <= 35) {
+				audioProcessor.envDepthMode = result - 33;
 			}
 			else if (result == 52) {
 				if (audioProcessor.uimode == UIMode::Seq) {
@@ -218,11 +337,11 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 				}
 			}
 			else if (result == 53) {
-				audioProcessor.viewPattern->copy();
+				audioProcessor.viewPattern->copy(*audioProcessor.clipboard);
 			}
 			else if (result == 54) {
 				auto snapshot = audioProcessor.viewPattern->points;
-				audioProcessor.viewPattern->paste();
+				audioProcessor.viewPattern->paste(*audioProcessor.clipboard);
 				audioProcessor.viewPattern->buildSegments();
 				audioProcessor.createUndoPointFromSnapshot(snapshot);
 			}
@@ -261,9 +380,10 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 					audioProcessor.viewPattern->loadTriangle();
 					audioProcessor.viewPattern->buildSegments();
 				}
-				if (result == 102) { // load random
+				if (result == 102 || result == 103) { // load random, again regenerates the last seed
 					int grid = audioProcessor.getCurrentGrid();
-					audioProcessor.viewPattern->loadRandom(grid);
+					auto seed = result == 102 ? audioProcessor.newPatternSeed() : audioProcessor.patternSeed;
+					audioProcessor.viewPattern->loadRandom(grid, seed, audioProcessor.randomOptions);
 					audioProcessor.viewPattern->buildSegments();
 				}
 				if (result >= 110 && result < 150) {
@@ -293,9 +413,26 @@ void SettingsButton::mouseDown(const juce::MouseEvent& e)
 			else if (result == 701) {
 				audioProcessor.bipolarCC = !audioProcessor.bipolarCC;
 			}
+			else if (result >= 710 && result <= 715) {
+				audioProcessor.outputATMIDILength = GATE12AudioProcessor::ATMIDI_NOTE_LENGTHS[result - 710];
+			}
+			else if (result == 720) {
+				audioProcessor.hitLog.setEnabled(!audioProcessor.hitLog.isEnabled());
+			}
+			else if (result == 721 || result == 722) {
+				MessageManager::callAsync([this, result] {
+					audioProcessor.hitLog.exportHits(result == 722);
+				});
+			}
+			else if (result == 723) {
+				audioProcessor.hitLog.clear();
+			}
 			else if (result == 1000) {
 				toggleAbout();
 			}
+			else if (result == 1005) {
+				toggleLibrary();
+			}
 			else if (result == 1001) {
 				MessageManager::callAsync([this] {
 					audioProcessor.importPatterns();
@@ -16,6 +16,7 @@ public:
     std::function<void()> onScaleChange;
     std::function<void()> toggleUIComponents;
     std::function<void()> toggleAbout;
+    std::function<void()> toggleLibrary;
 
 private:
     GATE12AudioProcessor& audioProcessor;
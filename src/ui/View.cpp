@@ -13,15 +13,18 @@
 
 View::View(GATE12AudioProcessor& p) : audioProcessor(p), multiSelect(p), paintTool(p)
 {
+    preSamples.resize(MAX_PLUG_WIDTH, 0.f); // samples array size must be >= viewport width
+    postSamples.resize(MAX_PLUG_WIDTH, 0.f);
+    sideSamples.resize(MAX_PLUG_WIDTH, 0.f);
+    audioProcessor.waveColumns.allocate(DISPLAY_RING_CAPACITY); // first editor open, instances without UI never allocate it
     setWantsKeyboardFocus(true);
-    startTimerHz(60);
 };
 
 View::~View()
 {
 };
 
-void View::timerCallback()
+void View::onFrame()
 {
     if (patternID != audioProcessor.viewPattern->versionID || audioProcessor.uimode != luimode) {
         if (audioProcessor.uimode != luimode)
@@ -44,10 +47,132 @@ void View::timerCallback()
         setEnabled(true);
     }
 
+    repaintDirty();
     luimode = audioProcessor.uimode;
+}
+
+void View::onResume()
+{
+    audioProcessor.waveColumns.clear();
+    std::fill(preSamples.begin(), preSamples.end(), 0.f);
+    std::fill(postSamples.begin(), postSamples.end(), 0.f);
+    std::fill(sideSamples.begin(), sideSamples.end(), 0.f);
     repaint();
 }
 
+// repaints only the regions that changed since the last tick
+// the seek line, new waveform columns and anything under the mouse
+// when the transport is stopped and the mouse is idle nothing is repainted
+void View::repaintDirty()
+{
+    auto pattern = audioProcessor.viewPattern;
+    auto version = pattern->curveVersion.load();
+    auto grid = audioProcessor.getCurrentGrid();
+    RectangleList<int> dirtyColumns;
+    bool cleared = readWaveColumns(dirtyColumns);
+    auto mouseOver = isMouseOver(true);
+    auto mouseDown = isMouseButtonDown(true);
+    auto mousePos = getMouseXYRelative();
+    auto seekBounds = getSeekBounds();
+
+    bool changed = pattern != lpattern || version != lcurveVersion || grid != lgrid
+        || cleared || audioProcessor.uimode != luimode
+        || audioProcessor.drawSidechain != ldrawSidechain || isEnabled() != lenabled
+        || mouseOver != lmouseOver || mouseDown || mouseDown != lmouseDown
+        || (mouseOver && mousePos != lmousePos);
+
+    if (changed) {
+        repaint();
+    }
+    else {
+        bool seekMoved = seekBounds.getNumRectangles() != lseekBounds.getNumRectangles()
+            || !std::equal(seekBounds.begin(), seekBounds.end(), lseekBounds.begin());
+        if (seekMoved) {
+            for (auto& r : lseekBounds) repaint(r);
+            for (auto& r : seekBounds) repaint(r);
+        }
+        for (auto& r : dirtyColumns)
+            repaint(r);
+    }
+
+    lpattern = pattern;
+    lcurveVersion = version;
+    lgrid = grid;
+    ldrawSidechain = audioProcessor.drawSidechain;
+    lenabled = isEnabled();
+    lmouseOver = mouseOver;
+    lmouseDown = mouseDown;
+    lmousePos = mousePos;
+    lseekBounds = seekBounds;
+}
+
+// reads the columns written by the audio thread since the last tick
+// adds the areas of consecutive columns to dirty, returns true if the waveforms were cleared
+bool View::readWaveColumns(RectangleList<int>& dirty)
+{
+    bool cleared = false;
+    int runStart = -1;
+    int runEnd = -1;
+
+    // one column margin on each side, the wave path joins adjacent columns
+    auto addRun = [&]() {
+        if (runStart >= 0)
+            dirty.add(winx + runStart - 1, winy, runEnd - runStart + 3, winh);
+    };
+
+    WaveColumn col;
+    while (audioProcessor.waveColumns.pop(col)) {
+        if (col.pos < 0 || col.pos >= (int)preSamples.size()) {
+            std::fill(preSamples.begin(), preSamples.end(), 0.f);
+            std::fill(postSamples.begin(), postSamples.end(), 0.f);
+            std::fill(sideSamples.begin(), sideSamples.end(), 0.f);
+            cleared = true;
+            continue;
+        }
+
+        preSamples[col.pos] = col.pre;
+        postSamples[col.pos] = col.post;
+        sideSamples[col.pos] = col.side;
+
+        if (runStart >= 0 && col.pos >= runStart && col.pos <= runEnd + 1) {
+            runEnd = std::max(runEnd, col.pos);
+        }
+        else {
+            addRun();
+            runStart = col.pos;
+            runEnd = col.pos;
+        }
+    }
+    addRun();
+
+    return cleared;
+}
+
+// bounds of the seek line and envelope position markers
+RectangleList<int> View::getSeekBounds()
+{
+    RectangleList<int> bounds;
+    if (audioProcessor.uimode == UIMode::PaintEdit)
+        return bounds;
+
+    auto xpos = audioProcessor.xenv.load();
+    auto ypos = audioProcessor.yenv.load();
+    int x = (int)(xpos * winw + winx);
+    int y = (int)((1 - ypos) * winh + winy);
+    bounds.add(Rectangle<int>(x - 7, y - 7, 14, 14));
+
+    if (audioProcessor.drawSeek.load())
+        bounds.add(Rectangle<int>(x - 2, winy - 1, 4, winh + 2));
+
+    if (audioProcessor.drawStereo.load()) {
+        int x2 = (int)(audioProcessor.xenv2.load() * winw + winx);
+        int y2 = (int)((1 - audioProcessor.yenv2.load()) * winh + winy);
+        bounds.add(Rectangle<int>(x2 - 7, y2 - 7, 14, 14));
+    }
+
+    return bounds;
+}
+
 void View::resized()
 {
     auto bounds = getLocalBounds();
@@ -56,6 +181,11 @@ void View::resized()
     winw = bounds.getWidth() - PLUG_PADDING * 2;
     winh = bounds.getHeight() - PLUG_PADDING * 2 - 10;
 
+    // columns written for the previous width no longer line up
+    std::fill(preSamples.begin(), preSamples.end(), 0.f);
+    std::fill(postSamples.begin(), postSamples.end(), 0.f);
+    std::fill(sideSamples.begin(), sideSamples.end(), 0.f);
+
     multiSelect.setViewBounds(winx, winy, winw, winh);
     paintTool.setViewBounds(winx, winy, winw, winh);
     audioProcessor.sequencer->setViewBounds(winx, winy, winw, winh);
@@ -68,6 +198,7 @@ void View::resized()
 }
 
 void View::paint(Graphics& g) {
+    FrameScheduler::ScopedPaint paintTimer(*this);
     g.setColour(Colour(COLOR_BG));
     g.fillRect(winx,winy,winw,winh);
     auto uimode = audioProcessor.uimode;
@@ -84,10 +215,10 @@ void View::paint(Graphics& g) {
 
     if (uimode == UIMode::Normal || uimode == UIMode::Seq) {
         if (audioProcessor.drawSidechain) {
-            drawWave(g, audioProcessor.sideSamples, Colour(COLOR_ACTIVE).brighter(0.75f));
+            drawWave(g, sideSamples, Colour(COLOR_ACTIVE).brighter(0.75f));
         }
-        drawWave(g, audioProcessor.preSamples, Colour(0xff7f7f7f));
-        drawWave(g, audioProcessor.postSamples, Colour(COLOR_ACTIVE));
+        drawWave(g, preSamples, Colour(0xff7f7f7f));
+        drawWave(g, postSamples, Colour(COLOR_ACTIVE));
     }
 
     drawGrid(g);
@@ -139,13 +270,13 @@ void View::paint(Graphics& g) {
         audioProcessor.sequencer->draw(g);
 }
 
-void View::drawWave(Graphics& g, std::vector<double>& samples, Colour color) const
+void View::drawWave(Graphics& g, const std::vector<float>& samples, Colour color) const
 {
     Path wavePath;
     wavePath.startNewSubPath((float)winx, (float)(winy + winh));
 
     for (int i = 0; i < winw; ++i) {
-        double ypos = std::min(std::abs(samples[i]), 1.0);
+        double ypos = std::min((double)samples[i], 1.0);
         float x = (float)(i + winx);
         float y = (float)(winh - ypos * winh + winy);
 
@@ -196,28 +327,65 @@ void View::drawGrid(Graphics& g)
 
 void View::drawSegments(Graphics& g)
 {
-    double lastX = winx;
-    double lastY = audioProcessor.viewPattern->get_y_at(0) * winh + winy;
+    auto pat = audioProcessor.viewPattern;
+    auto version = pat->curveVersion.load();
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (curveImage.isNull() || curvePattern != pat || curveVersion != version
+        || curveW != winw || curveH != winh || curveScale != scale)
+    {
+        renderCurve(scale);
+        curvePattern = pat;
+        curveVersion = version;
+        curveW = winw;
+        curveH = winh;
+        curveScale = scale;
+    }
+
+    if (curveImage.isValid())
+        g.drawImage(curveImage, Rectangle<float>((float)winx, (float)winy - 1.f, (float)winw + 1.f, (float)winh + 2.f));
+}
+
+// rasterizes the view pattern into curveImage, the image spans the view area
+// plus one pixel on each side so the stroke is not clipped at the edges
+void View::renderCurve(float scale)
+{
+    int imgw = (int)std::ceil((winw + 1) * scale);
+    int imgh = (int)std::ceil((winh + 2) * scale);
+    if (winw <= 0 || winh <= 0 || imgw <= 0 || imgh <= 0) {
+        curveImage = Image();
+        return;
+    }
+
+    if (curveImage.isNull() || curveImage.getWidth() != imgw || curveImage.getHeight() != imgh)
+        curveImage = Image(Image::ARGB, imgw, imgh, true);
+    else
+        curveImage.clear(curveImage.getBounds());
+
+    Graphics g(curveImage);
+    g.addTransform(AffineTransform::scale(scale).translated(0.f, scale));
+
+    auto pat = audioProcessor.viewPattern;
+    double lastY = pat->get_y_at(0) * winh;
 
     Path linePath;
     Path shadePath;
 
-    linePath.startNewSubPath((float)lastX, (float)lastY);
-    shadePath.startNewSubPath((float)lastX, (float)(winy + winh)); // Start from bottom
-    shadePath.lineTo((float)lastX, (float)lastY);                   // Line to first point on wave
+    linePath.startNewSubPath(0.f, (float)lastY);
+    shadePath.startNewSubPath(0.f, (float)winh); // Start from bottom
+    shadePath.lineTo(0.f, (float)lastY);         // Line to first point on wave
 
     for (int i = 0; i < winw + 1; ++i)
     {
         double px = double(i) / double(winw);
-        double py = audioProcessor.viewPattern->get_y_at(px) * winh + winy;
-        float x = (float)(i + winx);
-        float y = (float)py;
+        float x = (float)i;
+        float y = (float)(pat->get_y_at(px) * winh);
 
         linePath.lineTo(x, y);
         shadePath.lineTo(x, y);
     }
 
-    shadePath.lineTo((float)(winw + winx), (float)(winy + winh)); // Bottom-right
+    shadePath.lineTo((float)winw, (float)winh); // Bottom-right
     shadePath.closeSubPath();
 
     g.setColour(Colours::white.withAlpha(0.125f));
@@ -359,8 +527,12 @@ void View::drawSeek(Graphics& g)
 
 uint64_t View::getHoveredPoint(int x, int y)
 {
-    auto points = audioProcessor.viewPattern->points;
-    for (auto i = 0; i < points.size(); ++i) {
+    auto& points = audioProcessor.viewPattern->points;
+    auto range = audioProcessor.viewPattern->getPointsInRange(
+        (x - winx - HOVER_RADIUS - 1) / (double)winw,
+        (x - winx + HOVER_RADIUS + 1) / (double)winw
+    );
+    for (auto i = range.first; i < range.second; ++i) {
         auto xx = (int)(points[i].x * winw + winx);
         auto yy = (int)(points[i].y * winh + winy);
         if (pointInRect(x, y, xx - HOVER_RADIUS, yy - HOVER_RADIUS, HOVER_RADIUS * 2, HOVER_RADIUS * 2)) {
@@ -372,9 +544,12 @@ uint64_t View::getHoveredPoint(int x, int y)
 
 uint64_t View::getHoveredMidpoint(int x, int y)
 {
-    auto segs = audioProcessor.viewPattern->getSegments();
-    for (auto i = 0; i < segs.size(); ++i) {
-        auto& seg = segs[i];
+    // midpoints lie inside their segment so only segments near x are tested
+    auto segs = audioProcessor.viewPattern->getSegmentsInRange(
+        (x - winx - MPOINT_HOVER_RADIUS - 1) / (double)winw,
+        (x - winx + MPOINT_HOVER_RADIUS + 1) / (double)winw
+    );
+    for (auto& [i, seg] : segs) {
         auto xy = getMidpointXY(seg);
         if (!isCollinear(seg) && seg.type != PointType::Hold && pointInRect(x, y, (int)xy[0] - MPOINT_HOVER_RADIUS,
             (int)xy[1] - MPOINT_HOVER_RADIUS, MPOINT_HOVER_RADIUS * 2, MPOINT_HOVER_RADIUS * 2))
@@ -387,23 +562,14 @@ uint64_t View::getHoveredMidpoint(int x, int y)
 
 PPoint& View::getPoint(uint64_t id)
 {
-    for (auto& point : audioProcessor.viewPattern->points) {
-        if (point.id == id) {
-            return point;
-        }
-    }
-    return dummyPoint;
+    auto idx = audioProcessor.viewPattern->getPointIndex(id);
+    return idx < 0 ? dummyPoint : audioProcessor.viewPattern->points[idx];
 }
 
 int View::getPointIndex(uint64_t id)
 {
-    auto sz = audioProcessor.viewPattern->points.size();
-    for (int i = 0; i < sz; ++i) {
-        if (audioProcessor.viewPattern->points[i].id == id) {
-            return i;
-        }
-    }
-    return 0;
+    auto idx = audioProcessor.viewPattern->getPointIndex(id);
+    return idx < 0 ? 0 : idx;
 }
 
 
@@ -853,11 +1019,11 @@ void View::showContextMenu(const juce::MouseEvent& event)
             multiSelect.deleteSelectedPoints();
         }
         else if (result == 5) {
-            audioProcessor.viewPattern->copy();
+            audioProcessor.viewPattern->copy(*audioProcessor.clipboard);
         }
         else if (result == 6) {
             auto snapshot = audioProcessor.viewPattern->points;
-            audioProcessor.viewPattern->paste();
+            audioProcessor.viewPattern->paste(*audioProcessor.clipboard);
             audioProcessor.viewPattern->buildSegments();
             audioProcessor.createUndoPointFromSnapshot(snapshot);
         }
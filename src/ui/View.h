@@ -13,12 +13,13 @@
 #include "../dsp/Pattern.h"
 #include "Multiselect.h"
 #include "PaintTool.h"
+#include "FrameScheduler.h"
 #include "../Globals.h"
 
 class GATE12AudioProcessor;
 using namespace globals;
 
-class View : public juce::Component, private juce::Timer
+class View : public juce::Component, public FrameScheduler::Client
 {
 public:
     int winx = 0;
@@ -29,16 +30,21 @@ public:
     View(GATE12AudioProcessor&);
     ~View() override;
     void resized() override;
-    void timerCallback() override;
+    void onFrame() override;
+    void onResume() override;
 
     void paint(Graphics& g) override;
-    void drawWave(Graphics& g, std::vector<double>& samples, Colour color) const;
+    void drawWave(Graphics& g, const std::vector<float>& samples, Colour color) const;
     void drawGrid(Graphics& g);
     void drawSegments(Graphics& g);
+    void renderCurve(float scale);
     void drawMidPoints(Graphics& g);
     void drawPoints(Graphics& g);
     void drawSeek(Graphics& g);
     void drawPreSelection(Graphics& g);
+    void repaintDirty();
+    bool readWaveColumns(RectangleList<int>& dirty);
+    RectangleList<int> getSeekBounds();
 
     int getPointIndex(uint64_t id);
     PPoint& getPoint(uint64_t id);
@@ -88,6 +94,30 @@ private:
 
     PPoint dummyPoint{ 0, 0.f, 0.f, 0.f, 1 };
 
+    // Curve cache, the envelope is only rasterized when its key changes
+    Image curveImage;
+    Pattern* curvePattern = nullptr;
+    uint64_t curveVersion = 0;
+    int curveW = 0;
+    int curveH = 0;
+    float curveScale = 0.f;
+
+    // Waveforms read from the processor display ring
+    std::vector<float> preSamples;
+    std::vector<float> postSamples;
+    std::vector<float> sideSamples;
+
+    // Dirty region tracking, anything not covered by these triggers a full repaint
+    Pattern* lpattern = nullptr;
+    uint64_t lcurveVersion = 0;
+    int lgrid = 0;
+    bool ldrawSidechain = false;
+    bool lenabled = true;
+    bool lmouseOver = false;
+    bool lmouseDown = false;
+    Point<int> lmousePos;
+    RectangleList<int> lseekBounds;
+
     // PaintTool
     PaintTool paintTool;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Lock wait counters of a process-wide mutex, read by the benchmarks to spot contention
+ * between instances on shared state.
+ */
+struct LockCounters
+{
+	std::atomic<uint64_t> contended = 0; // lock calls that found the mutex taken
+	std::atomic<uint64_t> waitNanos = 0; // time spent waiting by those calls
+
+	struct Snapshot
+	{
+		uint64_t contended = 0;
+		double waitMillis = 0.0;
+	};
+
+	Snapshot snapshot() const
+	{
+		return { contended.load(std::memory_order_relaxed), waitNanos.load(std::memory_order_relaxed) / 1e6 };
+	}
+};
+
+/**
+ * std::mutex that counts the lock calls that had to wait and for how long.
+ * Uncontended locks cost a single try_lock, the clock is only read when the mutex is taken.
+ * Meets Lockable, use it with std::lock_guard like a std::mutex.
+ */
+class CountingMutex
+{
+public:
+	explicit CountingMutex(LockCounters& c) : counters(c) {}
+
+	void lock()
+	{
+		if (mtx.try_lock())
+			return;
+
+		auto start = std::chrono::steady_clock::now();
+		mtx.lock();
+		auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		counters.contended.fetch_add(1, std::memory_order_relaxed);
+		counters.waitNanos.fetch_add((uint64_t)waited.count(), std::memory_order_relaxed);
+	}
+
+	bool try_lock()
+	{
+		if (mtx.try_lock())
+			return true;
+		counters.contended.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void unlock() { mtx.unlock(); }
+
+private:
+	std::mutex mtx;
+	LockCounters& counters;
+};
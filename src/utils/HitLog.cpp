@@ -0,0 +1,71 @@
+#include "HitLog.h"
+
+void HitLog::setEnabled(bool enable)
+{
+	if (enable && ring.capacity() == 0)
+		ring.resize(LOG_CAPACITY);
+	enabled.store(enable, std::memory_order_release);
+
+	if (enable) {
+		startTimer(DRAIN_INTERVAL_MS);
+	}
+	else {
+		stopTimer();
+		drain();
+	}
+}
+
+void HitLog::push(const Hit& hit)
+{
+	if (enabled.load(std::memory_order_acquire) && !ring.push(hit))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HitLog::clear()
+{
+	ring.clear();
+	hits.clear();
+	dropped.store(0, std::memory_order_relaxed);
+}
+
+void HitLog::drain()
+{
+	Hit hit;
+	while (ring.pop(hit))
+		hits.push_back(hit);
+}
+
+void HitLog::exportHits(bool inPPQ)
+{
+	drain();
+	mFileChooser.reset(new juce::FileChooser(exportWindowTitle, juce::File::getSpecialLocation(juce::File::commonDocumentsDirectory), "*.txt"));
+
+	mFileChooser->launchAsync(juce::FileBrowserComponent::saveMode |
+		juce::FileBrowserComponent::canSelectFiles |
+		juce::FileBrowserComponent::warnAboutOverwriting, [this, inPPQ](const juce::FileChooser& fc)
+		{
+			auto file = fc.getResult();
+			mFileChooser = nullptr;
+			if (file == juce::File{})
+				return;
+
+			drain();
+			juce::String text;
+			for (const auto& hit : hits) {
+				if (inPPQ)
+					text << juce::String(hit.ppq, 6);
+				else
+					text << juce::String(hit.sample);
+				text << " " << juce::String(hit.velocity, 4) << "\n";
+			}
+
+			if (!file.replaceWithText(text))
+			{
+				auto options = juce::MessageBoxOptions().withIconType(juce::MessageBoxIconType::WarningIcon)
+					.withTitle("Export Failed")
+					.withMessage("Failed to write hit log:\n" + file.getFullPathName())
+					.withButton("OK");
+				messageBox = juce::NativeMessageBox::showScopedAsync(options, nullptr);
+			}
+		});
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include "SPSCRing.h"
+
+/**
+ * HitLog records audio trigger hits for offline use (eg. drum replacement).
+ * The audio thread pushes hits into a preallocated ring,
+ * the message thread drains it periodically while recording and exports the timestamps to a text file.
+ * Hits that find the ring full are counted as dropped.
+ */
+class HitLog : private juce::Timer
+{
+public:
+	struct Hit
+	{
+		int64_t sample = 0; // timeline position in samples
+		double ppq = 0.0; // timeline position in quarter notes
+		float velocity = 0.f; // hit strength 0..1
+	};
+
+	HitLog() = default;
+	~HitLog() override = default;
+
+	/**
+	 * Message thread - allocates the ring on first use and starts recording
+	 */
+	void setEnabled(bool enable);
+	bool isEnabled() const { return enabled.load(std::memory_order_acquire); }
+
+	/**
+	 * Audio thread - records a hit, drops it if the log is full
+	 */
+	void push(const Hit& hit);
+
+	/**
+	 * Hits dropped because the ring was full since the last clear
+	 */
+	uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+	/**
+	 * Message thread - discards all recorded hits and resets the dropped count
+	 */
+	void clear();
+
+	/**
+	 * Opens a file chooser and writes one hit per line
+	 * @param inPPQ Write timestamps in quarter notes instead of samples
+	 */
+	void exportHits(bool inPPQ);
+
+private:
+	static constexpr size_t LOG_CAPACITY = 16384;
+	static constexpr int DRAIN_INTERVAL_MS = 500; // message thread drain period while recording
+	static constexpr const char* exportWindowTitle = "Export hit log to a file";
+
+	void drain();
+	void timerCallback() override { drain(); }
+
+	std::atomic<bool> enabled = false;
+	std::atomic<uint32_t> dropped = 0;
+	SPSCRing<Hit> ring;
+	std::vector<Hit> hits; // drained hits, message thread only
+	std::unique_ptr<juce::FileChooser> mFileChooser;
+	juce::ScopedMessageBox messageBox;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HitLog)
+};
@@ -0,0 +1,99 @@
+#include "PaintPatternStore.h"
+#include "../Presets.h"
+#include <sstream>
+#include <algorithm>
+
+PaintPatternStore::PaintPatternStore()
+{
+	for (int i = 0; i < globals::PAINT_PATS; ++i) {
+		slots[i] = makeDefault(i);
+	}
+}
+
+PaintPatternStore::Points PaintPatternStore::get(int index)
+{
+	std::lock_guard<CountingMutex> lock(mtx);
+	return slots[index];
+}
+
+void PaintPatternStore::set(int index, const std::vector<PPoint>& points)
+{
+	std::lock_guard<CountingMutex> lock(mtx);
+	auto& current = *slots[index];
+	bool same = current.size() == points.size() && std::equal(current.begin(), current.end(), points.begin(),
+		[](const PPoint& a, const PPoint& b) { return a.x == b.x && a.y == b.y && a.tension == b.tension && a.type == b.type; });
+
+	if (same)
+		return;
+
+	slots[index] = std::make_shared<const std::vector<PPoint>>(points);
+	texts[index] = toText(points);
+}
+
+void PaintPatternStore::restorePresets()
+{
+	std::lock_guard<CountingMutex> lock(mtx);
+	for (int i = 0; i < 8; ++i) {
+		slots[i] = makeDefault(i);
+		texts[i] = toText(*slots[i]);
+	}
+}
+
+void PaintPatternStore::load(juce::PropertiesFile& file)
+{
+	std::lock_guard<CountingMutex> lock(mtx);
+	for (int i = 0; i < globals::PAINT_PATS; ++i) {
+		auto text = file.getValue("paintpat" + juce::String(i), "");
+		if (text.isEmpty() || text == texts[i])
+			continue;
+
+		slots[i] = parse(text);
+		texts[i] = text;
+	}
+}
+
+void PaintPatternStore::save(juce::PropertiesFile& file)
+{
+	std::lock_guard<CountingMutex> lock(mtx);
+	for (int i = 0; i < globals::PAINT_PATS; ++i) {
+		if (texts[i].isEmpty())
+			texts[i] = toText(*slots[i]);
+		file.setValue("paintpat" + juce::String(i), juce::var(texts[i]));
+	}
+}
+
+PaintPatternStore::Points PaintPatternStore::makeDefault(int index)
+{
+	std::vector<PPoint> points;
+	if (index < 8) {
+		auto preset = Presets::getPaintPreset(index);
+		points.assign(preset.begin(), preset.end());
+	}
+	else {
+		points.push_back({ 0, 0.0, 1.0, 0.0, 1 });
+		points.push_back({ 0, 1.0, 0.0, 0.0, 1 });
+	}
+	return std::make_shared<const std::vector<PPoint>>(std::move(points));
+}
+
+PaintPatternStore::Points PaintPatternStore::parse(const juce::String& text)
+{
+	std::vector<PPoint> points;
+	std::istringstream iss(text.toStdString());
+	double x, y, tension;
+	int type;
+	while (iss >> x >> y >> tension >> type) {
+		points.push_back({ 0, x, y, tension, type });
+	}
+	std::stable_sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) { return a.x < b.x; });
+	return std::make_shared<const std::vector<PPoint>>(std::move(points));
+}
+
+juce::String PaintPatternStore::toText(const std::vector<PPoint>& points)
+{
+	std::ostringstream oss;
+	for (const auto& point : points) {
+		oss << point.x << " " << point.y << " " << point.tension << " " << point.type << " ";
+	}
+	return juce::String(oss.str());
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <memory>
+#include "CountingMutex.h"
+#include "../Globals.h"
+#include "../dsp/Pattern.h"
+
+/**
+ * Paint pattern points shared by all plugin instances.
+ *
+ * Paint patterns are user settings rather than project state, every instance used to
+ * parse and keep its own copy of the same 32 patterns. The store keeps one immutable
+ * copy of each slot per process, instances only copy a slot into their own Pattern
+ * the first time it is used and publish it back when the settings are saved.
+ *
+ * Shared by all plugin instances through juce::SharedResourcePointer.
+ */
+class PaintPatternStore
+{
+public:
+	using Points = std::shared_ptr<const std::vector<PPoint>>;
+
+	PaintPatternStore();
+
+	/**
+	 * Returns the points of a slot, the same pointer is returned until the slot changes
+	 */
+	Points get(int index);
+
+	/**
+	 * Replaces the points of a slot, no-op if the points are the same
+	 */
+	void set(int index, const std::vector<PPoint>& points);
+
+	/**
+	 * Resets the slots that have a paint preset
+	 */
+	void restorePresets();
+
+	/**
+	 * Reads the slots from the settings file, slots whose text is unchanged keep their points
+	 */
+	void load(juce::PropertiesFile& file);
+	void save(juce::PropertiesFile& file);
+
+	static const LockCounters& getLockCounters() { return lockCounters; }
+
+private:
+	static Points makeDefault(int index);
+	static Points parse(const juce::String& text);
+	static juce::String toText(const std::vector<PPoint>& points);
+
+	static inline LockCounters lockCounters; // process-wide, the store is shared by all instances
+	CountingMutex mtx{ lockCounters };
+	Points slots[globals::PAINT_PATS];
+	juce::String texts[globals::PAINT_PATS]; // settings text of each slot, empty until loaded or changed
+};
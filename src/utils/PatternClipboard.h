@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include "CountingMutex.h"
+#include "../dsp/Pattern.h"
+
+/**
+ * Copied pattern points, shared by all plugin instances through juce::SharedResourcePointer
+ * so a pattern copied in one instance can be pasted in another.
+ * Instances may run their message callbacks on different threads in some hosts, access is locked.
+ */
+class PatternClipboard
+{
+public:
+	void set(const std::vector<PPoint>& pts)
+	{
+		std::lock_guard<CountingMutex> lock(mtx);
+		points = pts;
+	}
+
+	/**
+	 * Copies the clipboard into dest, returns false and leaves dest unchanged when empty
+	 */
+	bool get(std::vector<PPoint>& dest) const
+	{
+		std::lock_guard<CountingMutex> lock(mtx);
+		if (points.empty())
+			return false;
+		dest = points;
+		return true;
+	}
+
+	static const LockCounters& getLockCounters() { return lockCounters; }
+
+private:
+	static inline LockCounters lockCounters; // process-wide, the clipboard is shared by all instances
+	mutable CountingMutex mtx{ lockCounters };
+	std::vector<PPoint> points;
+};
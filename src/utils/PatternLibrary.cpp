@@ -0,0 +1,369 @@
+#include "PatternLibrary.h"
+#include "PatternParser.h"
+#include <cstring>
+#include <algorithm>
+
+PatternLibrary::PatternLibrary() : juce::Thread("PatternLibrary")
+{
+}
+
+PatternLibrary::~PatternLibrary()
+{
+	signalThreadShouldExit();
+	notify(); // wakes the worker waiting for scan requests
+	stopThread(5000);
+}
+
+void PatternLibrary::setFolder(const juce::File& dir)
+{
+	if (dir == getFolder() && getIndex() != nullptr) {
+		refresh();
+		return;
+	}
+
+	{
+		std::lock_guard<CountingMutex> lock(indexmtx);
+		folder = dir;
+	}
+	folderVersion.fetch_add(1); // a running scan stops at its next file and the worker rescans
+
+	// load the newest index right away, the scan replaces it if the folder changed
+	auto indexes = dir.findChildFiles(juce::File::findFiles, false, indexPattern);
+	std::sort(indexes.begin(), indexes.end(), [](const juce::File& a, const juce::File& b) {
+		return a.getLastModificationTime() > b.getLastModificationTime();
+	});
+	std::shared_ptr<const Index> loaded;
+	for (auto& file : indexes) {
+		if ((loaded = openIndex(file)) != nullptr)
+			break;
+	}
+	{
+		std::lock_guard<CountingMutex> lock(indexmtx);
+		index = loaded;
+	}
+	version.fetch_add(1);
+	sendChangeMessage();
+
+	refresh();
+}
+
+juce::File PatternLibrary::getFolder()
+{
+	std::lock_guard<CountingMutex> lock(indexmtx);
+	return folder;
+}
+
+void PatternLibrary::refresh()
+{
+	if (getFolder() == juce::File())
+		return;
+
+	scanRequested.store(true);
+	if (!isThreadRunning())
+		startThread(juce::Thread::Priority::low);
+	else
+		notify();
+}
+
+std::shared_ptr<const PatternLibrary::Index> PatternLibrary::getIndex()
+{
+	std::lock_guard<CountingMutex> lock(indexmtx);
+	return index;
+}
+
+int PatternLibrary::size()
+{
+	auto idx = getIndex();
+	return idx ? (int)idx->header.entryCount : 0;
+}
+
+PatternLibrary::Entry PatternLibrary::getEntry(int i)
+{
+	auto idx = getIndex();
+	if (!idx || i < 0 || i >= (int)idx->header.entryCount)
+		return {};
+
+	auto rec = idx->read<EntryRecord>(idx->header.entriesOffset + (juce::uint64)i * sizeof(EntryRecord));
+	Entry entry;
+	entry.name = idx->readString(rec.nameOffset, rec.nameLength);
+	entry.source = (int)rec.source;
+	entry.bank = rec.bank;
+	entry.slot = rec.slot;
+	entry.pointCount = (int)rec.pointCount;
+	return entry;
+}
+
+std::vector<PPoint> PatternLibrary::getPoints(int i)
+{
+	std::vector<PPoint> points;
+	auto idx = getIndex();
+	if (!idx || i < 0 || i >= (int)idx->header.entryCount)
+		return points;
+
+	auto rec = idx->read<EntryRecord>(idx->header.entriesOffset + (juce::uint64)i * sizeof(EntryRecord));
+	points.reserve(rec.pointCount);
+	auto offset = idx->header.pointsOffset + rec.pointsOffset * sizeof(PointRecord);
+	for (juce::uint32 j = 0; j < rec.pointCount; ++j) {
+		auto p = idx->read<PointRecord>(offset + j * sizeof(PointRecord));
+		points.push_back({ 0, p.x, p.y, p.tension, p.type });
+	}
+	return points;
+}
+
+juce::StringArray PatternLibrary::getSources()
+{
+	auto idx = getIndex();
+	return idx ? idx->sources : juce::StringArray();
+}
+
+juce::StringArray PatternLibrary::getSourceErrors()
+{
+	auto idx = getIndex();
+	return idx ? idx->errors : juce::StringArray();
+}
+
+std::vector<int> PatternLibrary::search(const juce::String& query, int source)
+{
+	std::vector<int> result;
+	auto idx = getIndex();
+	if (!idx)
+		return result;
+
+	auto words = juce::StringArray::fromTokens(query.toLowerCase(), " ", "\"");
+	words.removeEmptyStrings();
+
+	result.reserve(idx->searchNames.size());
+	for (int i = 0; i < (int)idx->searchNames.size(); ++i) {
+		if (source >= 0 && idx->entrySources[i] != source)
+			continue;
+
+		bool match = true;
+		for (auto& word : words) {
+			if (!idx->searchNames[i].contains(word)) {
+				match = false;
+				break;
+			}
+		}
+		if (match)
+			result.push_back(i);
+	}
+	return result;
+}
+
+//==============================================================================
+
+template <typename T>
+T PatternLibrary::Index::read(juce::uint64 offset) const
+{
+	T value{};
+	if (offset + sizeof(T) <= mapped->getSize())
+		std::memcpy(&value, static_cast<const char*>(mapped->getData()) + offset, sizeof(T));
+	return value;
+}
+
+juce::String PatternLibrary::Index::readString(juce::uint32 offset, juce::uint32 length) const
+{
+	auto start = header.stringsOffset + offset;
+	if (start + length > mapped->getSize())
+		return {};
+	return juce::String::fromUTF8(static_cast<const char*>(mapped->getData()) + start, (int)length);
+}
+
+std::shared_ptr<PatternLibrary::Index> PatternLibrary::openIndex(const juce::File& file)
+{
+	auto idx = std::make_shared<Index>();
+	idx->file = file;
+	idx->mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+	if (idx->mapped->getData() == nullptr || idx->mapped->getSize() < sizeof(Header))
+		return nullptr;
+
+	idx->header = idx->read<Header>(0);
+	auto& h = idx->header;
+	auto size = idx->mapped->getSize();
+	if (h.magic != MAGIC || h.version != FORMAT_VERSION
+		|| h.sourcesOffset + (juce::uint64)h.sourceCount * sizeof(SourceRecord) > size
+		|| h.entriesOffset + (juce::uint64)h.entryCount * sizeof(EntryRecord) > size
+		|| h.stringsOffset > size || h.pointsOffset > size)
+		return nullptr;
+
+	for (juce::uint32 i = 0; i < h.sourceCount; ++i) {
+		auto rec = idx->read<SourceRecord>(h.sourcesOffset + i * sizeof(SourceRecord));
+		idx->sources.add(idx->readString(rec.pathOffset, rec.pathLength));
+		idx->errors.add(rec.errorLength > 0 ? idx->readString(rec.errorOffset, rec.errorLength) : juce::String());
+	}
+
+	// names are kept in memory lower cased so search does not decode the index every time
+	idx->searchNames.reserve(h.entryCount);
+	idx->entrySources.reserve(h.entryCount);
+	for (juce::uint32 i = 0; i < h.entryCount; ++i) {
+		auto rec = idx->read<EntryRecord>(h.entriesOffset + (juce::uint64)i * sizeof(EntryRecord));
+		auto source = rec.source < (juce::uint32)idx->sources.size() ? idx->sources[(int)rec.source] : juce::String();
+		idx->searchNames.push_back((idx->readString(rec.nameOffset, rec.nameLength) + " " + source).toLowerCase());
+		idx->entrySources.push_back((int)rec.source);
+	}
+
+	return idx;
+}
+
+//==============================================================================
+
+// the worker waits for scan requests until the library is destroyed
+void PatternLibrary::run()
+{
+	while (!threadShouldExit()) {
+		if (scanRequested.exchange(false)) {
+			scanning.store(true);
+			scan();
+			scanning.store(false);
+			sendChangeMessage();
+		}
+		else {
+			wait(-1);
+		}
+	}
+}
+
+bool PatternLibrary::shouldCancelScan(juce::uint64 scanFolderVersion)
+{
+	return threadShouldExit() || folderVersion.load() != scanFolderVersion;
+}
+
+void PatternLibrary::scan()
+{
+	auto scanFolderVersion = folderVersion.load();
+	auto dir = getFolder();
+	if (!dir.isDirectory())
+		dir.createDirectory();
+
+	auto files = dir.findChildFiles(juce::File::findFiles, true, "*.12pat");
+	files.sort();
+	if (shouldCancelScan(scanFolderVersion))
+		return;
+
+	auto current = getIndex();
+	if (isIndexCurrent(current.get(), dir, files))
+		return;
+
+	auto dest = dir.getChildFile("library-" + juce::String(juce::Time::currentTimeMillis()) + ".idx");
+	if (!writeIndex(dir, files, dest, scanFolderVersion) || shouldCancelScan(scanFolderVersion)) {
+		dest.deleteFile();
+		return;
+	}
+
+	auto loaded = openIndex(dest);
+	if (!loaded)
+		return;
+
+	{
+		std::lock_guard<CountingMutex> lock(indexmtx);
+		if (folderVersion.load() != scanFolderVersion)
+			return; // the folder changed after the last check, the index is kept for the next scan of it
+		index = loaded;
+	}
+	version.fetch_add(1);
+	removeOldIndexes(dir, dest);
+}
+
+bool PatternLibrary::isIndexCurrent(const Index* idx, const juce::File& dir, const juce::Array<juce::File>& files)
+{
+	if (idx == nullptr || (int)idx->header.sourceCount != files.size())
+		return false;
+
+	for (int i = 0; i < files.size(); ++i) {
+		auto rec = idx->read<SourceRecord>(idx->header.sourcesOffset + (juce::uint64)i * sizeof(SourceRecord));
+		if (idx->sources[i] != files[i].getRelativePathFrom(dir)
+			|| rec.modified != files[i].getLastModificationTime().toMilliseconds()
+			|| rec.size != files[i].getSize())
+			return false;
+	}
+	return true;
+}
+
+// layout: header, sources, entries, points, strings
+bool PatternLibrary::writeIndex(const juce::File& dir, const juce::Array<juce::File>& files, const juce::File& dest, juce::uint64 scanFolderVersion)
+{
+	std::vector<SourceRecord> sources;
+	std::vector<EntryRecord> entries;
+	std::vector<PointRecord> points;
+	juce::MemoryOutputStream strings;
+
+	auto addString = [&strings](const juce::String& str, juce::uint32& offset, juce::uint32& length) {
+		offset = (juce::uint32)strings.getDataSize();
+		length = (juce::uint32)str.getNumBytesAsUTF8();
+		strings.write(str.toRawUTF8(), length);
+	};
+
+	for (int f = 0; f < files.size(); ++f) {
+		if (shouldCancelScan(scanFolderVersion))
+			return false;
+
+		auto& file = files[f];
+		SourceRecord src{};
+		addString(file.getRelativePathFrom(dir), src.pathOffset, src.pathLength);
+		src.modified = file.getLastModificationTime().toMilliseconds();
+		src.size = file.getSize();
+
+		// a file with errors may have patterns cut halfway, it is listed with its error and no entries
+		auto result = PatternParser::parseFile(file);
+		if (!result.ok()) {
+			addString(result.errors[0].toString(), src.errorOffset, src.errorLength);
+			sources.push_back(src);
+			continue;
+		}
+		sources.push_back(src);
+
+		auto title = file.getFileNameWithoutExtension();
+		for (size_t b = 0; b < result.banks.size(); ++b) {
+			auto& bank = result.banks[b];
+			for (size_t s = 0; s < bank.patterns.size(); ++s) {
+				auto& pts = bank.patterns[s];
+				if (pts.empty())
+					continue;
+
+				EntryRecord rec{};
+				auto name = (bank.name.isEmpty() ? title : bank.name) + " " + juce::String((int)s + 1);
+				addString(name, rec.nameOffset, rec.nameLength);
+				rec.source = (juce::uint32)f;
+				rec.bank = (juce::uint16)b;
+				rec.slot = (juce::uint16)s;
+				rec.pointsOffset = points.size();
+				rec.pointCount = (juce::uint32)pts.size();
+				for (auto& p : pts)
+					points.push_back({ p.x, p.y, p.tension, p.type, 0 });
+				entries.push_back(rec);
+			}
+		}
+	}
+
+	Header h{};
+	h.magic = MAGIC;
+	h.version = FORMAT_VERSION;
+	h.sourceCount = (juce::uint32)sources.size();
+	h.entryCount = (juce::uint32)entries.size();
+	h.sourcesOffset = sizeof(Header);
+	h.entriesOffset = h.sourcesOffset + sources.size() * sizeof(SourceRecord);
+	h.pointsOffset = h.entriesOffset + entries.size() * sizeof(EntryRecord);
+	h.stringsOffset = h.pointsOffset + points.size() * sizeof(PointRecord);
+
+	juce::FileOutputStream out(dest);
+	if (!out.openedOk())
+		return false;
+	out.setPosition(0);
+	out.truncate();
+	out.write(&h, sizeof(Header));
+	out.write(sources.data(), sources.size() * sizeof(SourceRecord));
+	out.write(entries.data(), entries.size() * sizeof(EntryRecord));
+	out.write(points.data(), points.size() * sizeof(PointRecord));
+	out.write(strings.getData(), strings.getDataSize());
+	out.flush();
+	return out.getStatus().wasOk();
+}
+
+// indexes still mapped by another instance fail to delete on some systems, they are retried on the next scan
+void PatternLibrary::removeOldIndexes(const juce::File& dir, const juce::File& current)
+{
+	for (auto& file : dir.findChildFiles(juce::File::findFiles, false, indexPattern)) {
+		if (file != current)
+			file.deleteFile();
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "CountingMutex.h"
+#include <atomic>
+#include "../dsp/Pattern.h"
+
+/**
+ * Pattern library on disk.
+ *
+ * The library is a folder of .12pat files, every pattern of every bank is an entry.
+ * Entries are kept in a binary index file that is memory mapped, records are read
+ * on demand so opening a library with thousands of patterns only maps the file.
+ * A worker thread rescans the folder and rewrites the index when files change.
+ * Files that fail to parse are listed with their first error and contribute no entries.
+ *
+ * Shared by all plugin instances through juce::SharedResourcePointer,
+ * listeners are notified with a change message when a new index is loaded.
+ */
+class PatternLibrary : public juce::ChangeBroadcaster, private juce::Thread
+{
+public:
+	static constexpr juce::uint32 MAGIC = 0x4c323147; // "G12L"
+	static constexpr juce::uint32 FORMAT_VERSION = 2;
+	static constexpr const char* indexPattern = "library-*.idx";
+
+	struct Entry
+	{
+		juce::String name;
+		int source = 0; // index of the source file in getSources()
+		int bank = 0;
+		int slot = 0;
+		int pointCount = 0;
+	};
+
+	PatternLibrary();
+	~PatternLibrary() override;
+
+	/**
+	 * Message thread - sets the library folder and loads its index, rescans in the background
+	 * A scan of the previous folder is cancelled at its next file, this never waits for it
+	 */
+	void setFolder(const juce::File& folder);
+	juce::File getFolder();
+
+	/**
+	 * Rescans the folder in the background, the index is rewritten only if files changed
+	 */
+	void refresh();
+	bool isScanning() const { return scanning.load(); }
+
+	int size();
+	Entry getEntry(int index);
+	std::vector<PPoint> getPoints(int index);
+	juce::StringArray getSources();
+
+	/**
+	 * First parse error of each source, empty for sources that parsed, same order as getSources()
+	 */
+	juce::StringArray getSourceErrors();
+
+	/**
+	 * Indexes of entries whose name contains all the words of query, case insensitive
+	 * @param source Only entries from this source file, -1 for all
+	 */
+	std::vector<int> search(const juce::String& query, int source = -1);
+
+	/**
+	 * Bumped every time a new index is loaded, entry indexes are only valid for the same version
+	 */
+	juce::uint64 getVersion() const { return version.load(); }
+
+	static const LockCounters& getLockCounters() { return lockCounters; }
+
+private:
+	struct Header
+	{
+		juce::uint32 magic;
+		juce::uint32 version;
+		juce::uint32 sourceCount;
+		juce::uint32 entryCount;
+		juce::uint64 sourcesOffset;
+		juce::uint64 entriesOffset;
+		juce::uint64 pointsOffset;
+		juce::uint64 stringsOffset;
+	};
+
+	struct SourceRecord
+	{
+		juce::uint32 pathOffset; // relative path in the strings section
+		juce::uint32 pathLength;
+		juce::int64 modified;
+		juce::int64 size;
+		juce::uint32 errorOffset; // first parse error in the strings section, the source has no entries
+		juce::uint32 errorLength; // zero when the source parsed
+	};
+
+	struct EntryRecord
+	{
+		juce::uint32 nameOffset;
+		juce::uint32 nameLength;
+		juce::uint32 source;
+		juce::uint16 bank;
+		juce::uint16 slot;
+		juce::uint64 pointsOffset; // first point in the points section
+		juce::uint32 pointCount;
+		juce::uint32 reserved;
+	};
+
+	struct PointRecord
+	{
+		double x;
+		double y;
+		double tension;
+		juce::int32 type;
+		juce::int32 reserved;
+	};
+
+	struct Index
+	{
+		std::unique_ptr<juce::MemoryMappedFile> mapped;
+		juce::File file;
+		Header header{};
+		juce::StringArray sources;
+		juce::StringArray errors;
+		std::vector<juce::String> searchNames; // lower case names, used by search
+		std::vector<int> entrySources;
+
+		template <typename T>
+		T read(juce::uint64 offset) const;
+		juce::String readString(juce::uint32 offset, juce::uint32 length) const;
+	};
+
+	void run() override;
+	void scan();
+	bool shouldCancelScan(juce::uint64 scanFolderVersion);
+	std::shared_ptr<const Index> getIndex();
+	static std::shared_ptr<Index> openIndex(const juce::File& file);
+	static bool isIndexCurrent(const Index* index, const juce::File& dir, const juce::Array<juce::File>& files);
+	bool writeIndex(const juce::File& dir, const juce::Array<juce::File>& files, const juce::File& dest, juce::uint64 scanFolderVersion);
+	static void removeOldIndexes(const juce::File& dir, const juce::File& current);
+
+	juce::File folder;
+	static inline LockCounters lockCounters; // process-wide, the library is shared by all instances
+	CountingMutex indexmtx{ lockCounters }; // guards index and folder
+	std::shared_ptr<const Index> index;
+	std::atomic<juce::uint64> version = 0;
+	std::atomic<juce::uint64> folderVersion = 0; // bumped when the folder changes, cancels a scan in progress
+	std::atomic<bool> scanRequested = false;
+	std::atomic<bool> scanning = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PatternLibrary)
+};
@@ -4,6 +4,7 @@
 #include "../Globals.h"
 #include "../PluginProcessor.h"
 #include <sstream>
+#include <memory>
 
 constexpr int PATTERN_COUNT{ 12 };
 void PatternManager::importPatterns(Pattern* patterns[PATTERN_COUNT],const TensionParameters& tensionParameters)
@@ -22,28 +23,40 @@ void PatternManager::importPatterns(Pattern* patterns[PATTERN_COUNT],const Tensi
 				if (!file.existsAsFile())
 					return;
 
-				juce::String fileContent = file.loadFileAsString();
-				std::istringstream iss(fileContent.toStdString());
-
-				for (int i = 0; i < PATTERN_COUNT; ++i)
+				auto result = PatternParser::parseFile(file);
+				if (!result.ok())
 				{
-					patterns[i]->clear();
-					patterns[i]->clearUndo();
-
-					double x, y, tension;
-					int type;
-					std::string line;
-
-					if (!std::getline(iss, line))
-						break;
+					juce::String message;
+					for (size_t i = 0; i < result.errors.size() && i < 5; ++i)
+						message << result.errors[i].toString() << "\n";
+					if (result.errors.size() > 5)
+						message << "(" << juce::String((int)result.errors.size() - 5) << " more)";
 
-					std::istringstream lineStream(line);
-					while (lineStream >> x >> y >> tension >> type)
+					auto options = juce::MessageBoxOptions().withIconType(juce::MessageBoxIconType::WarningIcon)
+						.withTitle("Import Failed")
+						.withMessage("Invalid pattern file " + file.getFileName() + "\n" + message)
+						.withButton("OK");
+					messageBox = juce::NativeMessageBox::showScopedAsync(options, nullptr);
+				}
+				else if (result.banks.size() == 1)
+				{
+					applyBank(result.banks[0], patterns, tensionParameters);
+				}
+				else if (result.banks.size() > 1)
+				{
+					// multi bank file, let the user pick which bank to load
+					auto banks = std::make_shared<std::vector<PatternParser::Bank>>(std::move(result.banks));
+					juce::PopupMenu menu;
+					for (int i = 0; i < (int)banks->size(); ++i)
 					{
-						patterns[i]->insertPoint(x, y, tension, type, false);
+						auto& name = (*banks)[i].name;
+						menu.addItem(i + 1, name.isEmpty() ? "Bank " + juce::String(i + 1) : name);
 					}
-					patterns[i]->setTension(tensionParameters.tension, tensionParameters.tensionAtk, tensionParameters.tensionRel, tensionParameters.dualTension);
-					patterns[i]->buildSegments();
+					menu.showMenuAsync(juce::PopupMenu::Options(), [banks, patterns, tensionParameters](int result)
+						{
+							if (result > 0)
+								applyBank((*banks)[result - 1], patterns, tensionParameters);
+						});
 				}
 			}
 
@@ -51,6 +64,19 @@ void PatternManager::importPatterns(Pattern* patterns[PATTERN_COUNT],const Tensi
 		}, nullptr);
 }
 
+void PatternManager::applyBank(const PatternParser::Bank& bank, Pattern* patterns[PATTERN_COUNT], const TensionParameters& tensionParameters)
+{
+	for (int i = 0; i < PATTERN_COUNT; ++i)
+	{
+		patterns[i]->clear();
+		patterns[i]->clearUndo();
+		if (i < (int)bank.patterns.size())
+			patterns[i]->insertPoints(bank.patterns[i]);
+		patterns[i]->setTension(tensionParameters.tension, tensionParameters.tensionAtk, tensionParameters.tensionRel, tensionParameters.dualTension);
+		patterns[i]->buildSegments();
+	}
+}
+
 void PatternManager::exportPatterns(Pattern* patterns[PATTERN_COUNT])
 {
 	mFileChooser.reset(new juce::FileChooser(exportWindowTitle, juce::File::getSpecialLocation(juce::File::commonDocumentsDirectory), patternExtension));
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include <memory>
 #include <functional>
+#include "PatternParser.h"
 
 // Forward declarations
 class Pattern;
@@ -20,7 +21,7 @@ public:
     PatternManager() = default;
     ~PatternManager() = default;    
     /**
-     * Import patterns from a .12pat file
+     * Import patterns from a .12pat file, files with multiple banks ask which bank to load
      * @param patterns Array of 12 Pattern pointers to import into
      * @param sequencer Pointer to the sequencer for UI mode handling
      * @param tensionParameters Struct holding the tension parameters
@@ -35,6 +36,8 @@ public:
     void exportPatterns(Pattern* patterns[12]);
 
 private:
+    static void applyBank(const PatternParser::Bank& bank, Pattern* patterns[12], const TensionParameters& tensionParameters);
+
     static constexpr const char* patternExtension= "*.12pat";
     static constexpr const char* exportWindowTitle= "Export Patterns to a file";
     static constexpr const char* importWindowTitle = "Import Patterns from a file";
@@ -0,0 +1,142 @@
+#include "PatternParser.h"
+#include <charconv>
+#include <cmath>
+#include <algorithm>
+
+juce::String PatternParser::Error::toString() const
+{
+	if (line == 0)
+		return message; // not tied to a position in the file
+	return "line " + juce::String(line) + ", column " + juce::String(column) + ": " + message;
+}
+
+PatternParser::Result PatternParser::parseFile(const juce::File& file)
+{
+	juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+	if (mapped.getData() != nullptr)
+		return parse(static_cast<const char*>(mapped.getData()), mapped.getSize());
+
+	juce::MemoryBlock block;
+	if (!file.loadFileAsData(block)) {
+		Result result;
+		result.errors.push_back({ 0, 0, "could not read " + file.getFullPathName() });
+		return result;
+	}
+	return parse(static_cast<const char*>(block.getData()), block.getSize());
+}
+
+PatternParser::Result PatternParser::parse(const char* data, size_t size)
+{
+	Result result;
+	const char* p = data;
+	const char* end = data + size;
+	int lineNum = 0;
+	bool bankHeader = false; // last bank was started by a header and may still be empty
+
+	auto error = [&](const char* lineStart, const char* at, const juce::String& message) {
+		result.errors.push_back({ lineNum, (int)(at - lineStart) + 1, message });
+	};
+
+	while (p < end && (int)result.errors.size() < MAX_ERRORS) {
+		const char* lineStart = p;
+		const char* lineEnd = std::find(p, end, '\n');
+		p = lineEnd < end ? lineEnd + 1 : end;
+		lineNum += 1;
+		if (lineEnd > lineStart && lineEnd[-1] == '\r')
+			lineEnd -= 1;
+
+		const char* c = lineStart;
+		while (c < lineEnd && (*c == ' ' || *c == '\t')) ++c;
+
+		if (c < lineEnd && *c == '#') {
+			result.banks.push_back({ juce::String(c + 1, (size_t)(lineEnd - c - 1)).trim(), {} });
+			bankHeader = true;
+			continue;
+		}
+
+		// a blank line at the end of the file is not an empty pattern
+		if (c == lineEnd && p == end)
+			break;
+
+		if (result.banks.empty() || (int)result.banks.back().patterns.size() == PATTERNS_PER_BANK) {
+			if (bankHeader && !result.banks.empty() && (int)result.banks.back().patterns.size() == PATTERNS_PER_BANK)
+				error(lineStart, c, "bank \"" + result.banks.back().name + "\" has more than 12 patterns");
+			result.banks.push_back({});
+			bankHeader = false;
+		}
+
+		std::vector<PPoint> points;
+		while (c < lineEnd) {
+			double x, y, tension;
+			int type;
+			const char* pointStart = c;
+			if (!parseDouble(c, lineEnd, x) || !parseDouble(c, lineEnd, y)
+				|| !parseDouble(c, lineEnd, tension) || !parseInt(c, lineEnd, type))
+			{
+				error(lineStart, c, c == lineEnd ? "incomplete point, expected x y tension type" : "invalid number");
+				break;
+			}
+			if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(tension)) {
+				error(lineStart, pointStart, "point value is not finite");
+				break;
+			}
+			if (type < PointType::Hold || type > PointType::HalfSine) {
+				error(lineStart, pointStart, "unknown point type " + juce::String(type));
+				break;
+			}
+			points.push_back({ 0, x, y, tension, type });
+			while (c < lineEnd && (*c == ' ' || *c == '\t')) ++c;
+		}
+
+		std::stable_sort(points.begin(), points.end(), [](const PPoint& a, const PPoint& b) { return a.x < b.x; });
+		result.banks.back().patterns.push_back(std::move(points));
+	}
+
+	bool empty = std::all_of(result.banks.begin(), result.banks.end(), [](const Bank& bank) { return bank.patterns.empty(); });
+	if (empty && result.errors.empty())
+		result.errors.push_back({ 0, 0, "no patterns found" });
+
+	return result;
+}
+
+// reads a number after optional whitespace and advances p past it
+bool PatternParser::parseDouble(const char*& p, const char* end, double& value)
+{
+	while (p < end && (*p == ' ' || *p == '\t')) ++p;
+	if (p < end && *p == '+') ++p; // from_chars does not accept a leading plus
+
+#if defined(__cpp_lib_to_chars)
+	auto [ptr, ec] = std::from_chars(p, end, value);
+	if (ec != std::errc() || ptr == p || (ptr < end && *ptr != ' ' && *ptr != '\t'))
+		return false;
+	p = ptr;
+	return true;
+#else
+	// floating point from_chars is missing on older standard libraries
+	// JUCE reads the number instead of strtod which follows the C locale decimal separator
+	char buf[64];
+	size_t len = 0;
+	while (p + len < end && len < sizeof(buf) - 1 && p[len] != ' ' && p[len] != '\t') {
+		buf[len] = p[len];
+		len += 1;
+	}
+	buf[len] = 0;
+	juce::CharPointer_ASCII ptr(buf);
+	value = juce::CharacterFunctions::readDoubleValue(ptr);
+	if (len == 0 || ptr.getAddress() != buf + len)
+		return false;
+	p += len;
+	return true;
+#endif
+}
+
+bool PatternParser::parseInt(const char*& p, const char* end, int& value)
+{
+	while (p < end && (*p == ' ' || *p == '\t')) ++p;
+	if (p < end && *p == '+') ++p;
+	auto [ptr, ec] = std::from_chars(p, end, value);
+	if (ec != std::errc() || ptr == p || (ptr < end && *ptr != ' ' && *ptr != '\t'))
+		return false;
+	p = ptr;
+	return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../dsp/Pattern.h"
+
+/**
+ * Parser for .12pat pattern files.
+ *
+ * Each line holds one pattern as a list of "x y tension type" points separated by spaces.
+ * A file holds one or more banks of 12 patterns, a line starting with # starts a new bank
+ * and the rest of the line is the bank name. Without headers every 12 lines form a bank,
+ * so files exported by previous versions are a single bank.
+ *
+ * Numbers are read in place with std::from_chars from a memory mapped file,
+ * malformed input is reported with line and column instead of being skipped silently.
+ */
+class PatternParser
+{
+public:
+	static constexpr int PATTERNS_PER_BANK = 12;
+	static constexpr int MAX_ERRORS = 100; // errors reported before parsing stops
+
+	struct Bank
+	{
+		juce::String name;
+		std::vector<std::vector<PPoint>> patterns; // up to PATTERNS_PER_BANK, points sorted by x
+	};
+
+	struct Error
+	{
+		int line = 0; // 1 based
+		int column = 0; // 1 based
+		juce::String message;
+
+		juce::String toString() const;
+	};
+
+	struct Result
+	{
+		std::vector<Bank> banks;
+		std::vector<Error> errors;
+
+		bool ok() const { return errors.empty(); }
+	};
+
+	/**
+	 * Parses text in memory, data does not need to be null terminated
+	 */
+	static Result parse(const char* data, size_t size);
+
+	/**
+	 * Memory maps and parses a file, falls back to reading it into memory if it can't be mapped
+	 */
+	static Result parseFile(const juce::File& file);
+
+private:
+	static bool parseDouble(const char*& p, const char* end, double& value);
+	static bool parseInt(const char*& p, const char* end, int& value);
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Single producer single consumer ring buffer.
+ * Storage is allocated once with resize() before the ring is shared between threads,
+ * or later by the consumer with allocate(), push and pop never allocate so they are
+ * safe to call from the audio thread. Pushing to a ring without storage drops the item.
+ * The producer only writes head and the consumer only writes tail.
+ */
+template <typename T>
+class SPSCRing
+{
+public:
+	SPSCRing() = default;
+	explicit SPSCRing(size_t capacity) { resize(capacity); }
+
+	/**
+	 * Allocates storage, not thread safe, call before producer and consumer start
+	 */
+	void resize(size_t capacity)
+	{
+		items.resize(capacity + 1); // one slot is kept free to tell full from empty
+		head.store(0);
+		tail.store(0);
+		slots.store(items.size(), std::memory_order_release);
+	}
+
+	/**
+	 * Consumer - allocates storage the first time it is called, safe while the producer is running
+	 * used for buffers that are only needed once the UI is open, storage is never released
+	 */
+	void allocate(size_t capacity)
+	{
+		if (slots.load(std::memory_order_acquire) > 0)
+			return;
+		items.resize(capacity + 1);
+		head.store(0);
+		tail.store(0);
+		slots.store(items.size(), std::memory_order_release); // publishes the storage to the producer
+	}
+
+	size_t capacity() const { auto n = slots.load(std::memory_order_acquire); return n == 0 ? 0 : n - 1; }
+
+	/**
+	 * Producer - returns false and drops the item when the ring is full
+	 */
+	bool push(const T& item)
+	{
+		auto n = slots.load(std::memory_order_acquire);
+		if (n == 0) return false;
+		auto h = head.load(std::memory_order_relaxed);
+		auto next = h + 1 == n ? 0 : h + 1;
+		if (next == tail.load(std::memory_order_acquire))
+			return false;
+		items[h] = item;
+		head.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Consumer - returns the oldest item without removing it or nullptr when empty
+	 */
+	T* front()
+	{
+		auto t = tail.load(std::memory_order_relaxed);
+		if (t == head.load(std::memory_order_acquire))
+			return nullptr;
+		return &items[t];
+	}
+
+	/**
+	 * Consumer
+	 */
+	bool pop(T& item)
+	{
+		auto t = tail.load(std::memory_order_relaxed);
+		if (t == head.load(std::memory_order_acquire))
+			return false;
+		item = items[t];
+		tail.store(t + 1 == slots.load(std::memory_order_relaxed) ? 0 : t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Consumer - removes the oldest item
+	 */
+	void pop()
+	{
+		auto t = tail.load(std::memory_order_relaxed);
+		if (t != head.load(std::memory_order_acquire))
+			tail.store(t + 1 == slots.load(std::memory_order_relaxed) ? 0 : t + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Consumer - discards every item pushed so far
+	 */
+	void clear()
+	{
+		tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	bool empty() const
+	{
+		return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+	}
+
+private:
+	std::vector<T> items;
+	std::atomic<size_t> slots{ 0 }; // items size, zero until storage is published
+	std::atomic<size_t> head{ 0 }; // next write index
+	std::atomic<size_t> tail{ 0 }; // next read index
+};
@@ -0,0 +1,64 @@
+#include "SettingsStore.h"
+
+SettingsStore::SettingsStore() : juce::Thread("SettingsStore")
+{
+	juce::PropertiesFile::Options options{};
+	options.applicationName = ProjectInfo::projectName;
+	options.filenameSuffix = ".settings";
+#if defined(JUCE_LINUX) || defined(JUCE_BSD)
+	options.folderName = "~/.config/gate12";
+#endif
+	options.osxLibrarySubFolder = "Application Support";
+	options.storageFormat = juce::PropertiesFile::storeAsXML;
+	options.millisecondsBeforeSaving = -1; // saved by this store, never on the message thread
+
+	file = std::make_unique<juce::PropertiesFile>(options);
+	syncTime = file->getFile().getLastModificationTime().toMilliseconds();
+	startThread(juce::Thread::Priority::background);
+}
+
+SettingsStore::~SettingsStore()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(2000);
+	save();
+}
+
+bool SettingsStore::reloadIfChanged()
+{
+	std::lock_guard<CountingMutex> lock(filemtx);
+	auto modified = file->getFile().getLastModificationTime().toMilliseconds();
+	if (modified == syncTime || file->needsToBeSaved())
+		return false;
+
+	file->reload();
+	syncTime = modified;
+	return true;
+}
+
+void SettingsStore::scheduleSave()
+{
+	notify();
+}
+
+void SettingsStore::run()
+{
+	while (!threadShouldExit()) {
+		wait(-1);
+
+		// wait until no save was requested for saveDelayMs
+		auto deadline = juce::Time::getMillisecondCounter() + (juce::uint32)maxSaveDelayMs;
+		while (!threadShouldExit() && juce::Time::getMillisecondCounter() < deadline && wait(saveDelayMs)) {}
+
+		if (!threadShouldExit())
+			save();
+	}
+}
+
+void SettingsStore::save()
+{
+	std::lock_guard<CountingMutex> lock(filemtx);
+	if (file->saveIfNeeded())
+		syncTime = file->getFile().getLastModificationTime().toMilliseconds();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include "CountingMutex.h"
+
+/**
+ * The user settings file, read once per process and shared by all plugin instances
+ * through juce::SharedResourcePointer.
+ *
+ * Instances change the cached properties on the message thread and call scheduleSave,
+ * the file is written by a background thread once no save was requested for saveDelayMs,
+ * so a burst of changes (resizing, many editors closing) becomes a single write.
+ * Pending changes are written when the last instance is destroyed.
+ */
+class SettingsStore : private juce::Thread
+{
+public:
+	SettingsStore();
+	~SettingsStore() override;
+
+	/**
+	 * The cached settings, PropertiesFile locks its values so it can be written while the UI changes them
+	 */
+	juce::PropertiesFile& getFile() { return *file; }
+
+	/**
+	 * Reloads the file if it was written by another process since it was last read or written,
+	 * changes not yet saved take precedence, returns true if the file was reloaded
+	 */
+	bool reloadIfChanged();
+
+	/**
+	 * Requests a write of the cached settings, repeated requests are coalesced
+	 */
+	void scheduleSave();
+
+	static const LockCounters& getLockCounters() { return lockCounters; }
+
+private:
+	static constexpr int saveDelayMs = 500;
+	static constexpr int maxSaveDelayMs = 5000; // writes are not postponed forever by continuous changes
+
+	void run() override;
+	void save();
+
+	static inline LockCounters lockCounters; // process-wide, the store is shared by all instances
+	CountingMutex filemtx{ lockCounters }; // serializes writing the file on the save thread and reloading it on the message thread
+	std::unique_ptr<juce::PropertiesFile> file;
+	std::atomic<juce::int64> syncTime = 0; // modification time of the file when last read or written
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SettingsStore)
+};
@@ -0,0 +1,184 @@
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer() : juce::Thread("SpectrumAnalyzer")
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+	stopThread(1000);
+}
+
+void SpectrumAnalyzer::start()
+{
+	if (isThreadRunning())
+		return;
+
+	if (!allocated.load())
+		allocate();
+
+	std::fill(history.begin(), history.end(), 0.f);
+	std::fill(magnitudes.begin(), magnitudes.end(), 0.f);
+	historyPos = 0;
+	hopCountdown = HOP_SIZE;
+	fifo.finishedRead(fifo.getNumReady()); // discard audio pushed while stopped
+	startThread(juce::Thread::Priority::low);
+}
+
+void SpectrumAnalyzer::stop()
+{
+	signalThreadShouldExit();
+	notify(); // wakes the worker from its wait instead of blocking the message thread until it times out
+	stopThread(1000);
+}
+
+void SpectrumAnalyzer::setSampleRate(double srate)
+{
+	sampleRate.store(srate);
+}
+
+void SpectrumAnalyzer::setColumns(int count)
+{
+	columns.store(std::max(0, count));
+}
+
+void SpectrumAnalyzer::push(const float* left, const float* right, int numSamples)
+{
+	if (!allocated.load(std::memory_order_acquire) || fifo.getFreeSpace() < numSamples)
+		return;
+
+	int start1, size1, start2, size2;
+	fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+	if (size1 > 0) {
+		std::copy_n(left, size1, fifoL.data() + start1);
+		std::copy_n(right, size1, fifoR.data() + start1);
+	}
+	if (size2 > 0) {
+		std::copy_n(left + size1, size2, fifoL.data() + start2);
+		std::copy_n(right + size1, size2, fifoR.data() + start2);
+	}
+	fifo.finishedWrite(size1 + size2);
+}
+
+bool SpectrumAnalyzer::getLevels(std::vector<float>& dest)
+{
+	std::lock_guard<std::mutex> lock(levelsmtx);
+	if (!levelsReady)
+		return false;
+	dest = levels;
+	levelsReady = false;
+	return true;
+}
+
+void SpectrumAnalyzer::run()
+{
+	while (!threadShouldExit()) {
+		readFifo();
+		wait(10);
+	}
+}
+
+// consumes the FIFO into the history buffer, analyzing every HOP_SIZE samples
+void SpectrumAnalyzer::readFifo()
+{
+	int ready = fifo.getNumReady();
+	if (ready == 0)
+		return;
+
+	int start1, size1, start2, size2;
+	fifo.prepareToRead(ready, start1, size1, start2, size2);
+
+	auto consume = [&](int start, int size) {
+		for (int i = start; i < start + size; ++i) {
+			history[historyPos] = 0.5f * (fifoL[i] + fifoR[i]);
+			historyPos = (historyPos + 1) % FFT_SIZE;
+			if (--hopCountdown == 0) {
+				hopCountdown = HOP_SIZE;
+				analyze();
+			}
+		}
+	};
+
+	consume(start1, size1);
+	consume(start2, size2);
+	fifo.finishedRead(size1 + size2);
+}
+
+void SpectrumAnalyzer::analyze()
+{
+	// unroll history starting from the oldest sample
+	int firstPart = FFT_SIZE - historyPos;
+	std::copy_n(history.data() + historyPos, firstPart, fftData.data());
+	std::copy_n(history.data(), historyPos, fftData.data() + firstPart);
+	std::fill(fftData.begin() + FFT_SIZE, fftData.end(), 0.f);
+
+	window->multiplyWithWindowingTable(fftData.data(), FFT_SIZE);
+	fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+	float norm = 1.f / (FFT_SIZE * 0.5f);
+	for (size_t j = 0; j < magnitudes.size(); ++j) {
+		float mag = fftData[j] * norm;
+		magnitudes[j] = mag * 0.8f + magnitudes[j] * 0.2f;
+	}
+
+	int count = columns.load();
+	double srate = sampleRate.load();
+	if (count != binsCount || srate != binsSrate)
+		buildColumnBins(count, srate);
+
+	// narrow columns interpolate between bins, wide columns take the peak bin
+	const int lastBin = (int)magnitudes.size() - 1;
+	for (int i = 0; i < count; ++i) {
+		auto [b0, b1] = columnBins[i];
+		float mag = 0.f;
+		if ((int)b1 - (int)b0 < 1) {
+			int bin = std::min((int)b0, lastBin - 1);
+			float frac = b0 - bin;
+			mag = magnitudes[bin] + (magnitudes[bin + 1] - magnitudes[bin]) * frac;
+		}
+		else {
+			for (int bin = (int)b0; bin <= std::min((int)b1, lastBin); ++bin)
+				mag = std::max(mag, magnitudes[bin]);
+		}
+		float db = juce::Decibels::gainToDecibels(mag, MIN_DB);
+		workLevels[i] = juce::jmap(db, MIN_DB, 0.f, 0.f, 1.f);
+	}
+
+	std::lock_guard<std::mutex> lock(levelsmtx);
+	levels.assign(workLevels.begin(), workLevels.begin() + count);
+	levelsReady = true;
+}
+
+// maps each display column to its fft bin range using the same log scale as the display
+void SpectrumAnalyzer::buildColumnBins(int count, double srate)
+{
+	binsCount = count;
+	binsSrate = srate;
+	columnBins.resize(count);
+	workLevels.resize(count, 0.f);
+
+	const float binsPerHz = (float)(FFT_SIZE / srate);
+	const float lastBin = (float)(magnitudes.size() - 1);
+	auto freqAt = [count](int x) {
+		return MIN_FREQ * std::pow(MAX_FREQ / MIN_FREQ, (float)x / (float)count);
+	};
+
+	for (int i = 0; i < count; ++i) {
+		float b0 = std::min(freqAt(i) * binsPerHz, lastBin);
+		float b1 = std::min(freqAt(i + 1) * binsPerHz, lastBin);
+		columnBins[i] = { b0, b1 };
+	}
+}
+
+// buffers are only needed while the bands editor is shown, instances that never open it skip them
+void SpectrumAnalyzer::allocate()
+{
+	fifoL.resize(fifo.getTotalSize(), 0.f);
+	fifoR.resize(fifo.getTotalSize(), 0.f);
+	history.resize(FFT_SIZE, 0.f);
+	fftData.resize(FFT_SIZE * 2, 0.f);
+	magnitudes.resize(FFT_SIZE / 2, 0.f);
+	fft = std::make_unique<juce::dsp::FFT>(globals::BANDS_FFT_ORDER);
+	window = std::make_unique<juce::dsp::WindowingFunction<float>>(FFT_SIZE, juce::dsp::WindowingFunction<float>::blackmanHarris);
+	allocated.store(true, std::memory_order_release);
+}
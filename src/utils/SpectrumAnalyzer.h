@@ -0,0 +1,83 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "../Globals.h"
+
+/**
+ * Spectrum analyzer used by the band splitter display.
+ * The audio thread copies each block into a lock-free FIFO,
+ * a worker thread runs a windowed FFT every hop and aggregates the bins
+ * into one level per display column, the UI only draws the ready levels.
+ */
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+	static constexpr int FFT_SIZE = 1 << globals::BANDS_FFT_ORDER;
+	static constexpr int HOP_SIZE = FFT_SIZE / 4; // 75% overlap between analysis frames
+	static constexpr float MIN_DB = -90.f;
+	static constexpr float MIN_FREQ = 20.f;
+	static constexpr float MAX_FREQ = 20000.f;
+
+	SpectrumAnalyzer();
+	~SpectrumAnalyzer() override;
+
+	/**
+	 * Message thread - starts and stops the worker, called by the display
+	 */
+	void start();
+	void stop();
+
+	void setSampleRate(double srate);
+
+	/**
+	 * Message thread - number of log spaced columns the levels are aggregated into
+	 */
+	void setColumns(int count);
+
+	/**
+	 * Audio thread - copies a block into the FIFO, drops the block if the worker is behind
+	 */
+	void push(const float* left, const float* right, int numSamples);
+
+	/**
+	 * Message thread - copies the latest levels, one per column normalized from MIN_DB to 0dB
+	 * returns false if there are no new levels since the last call
+	 */
+	bool getLevels(std::vector<float>& dest);
+
+private:
+	void run() override;
+	void readFifo();
+	void analyze();
+	void buildColumnBins(int count, double srate);
+	void allocate();
+
+	std::atomic<bool> allocated = false; // buffers are allocated on the first start, push drops audio until then
+	juce::AbstractFifo fifo{ FFT_SIZE * 4 };
+	std::vector<float> fifoL;
+	std::vector<float> fifoR;
+
+	std::unique_ptr<juce::dsp::FFT> fft;
+	std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+	std::vector<float> history; // circular buffer with the last FFT_SIZE mono samples
+	int historyPos = 0;
+	int hopCountdown = HOP_SIZE;
+	std::vector<float> fftData;
+	std::vector<float> magnitudes; // smoothed bin magnitudes
+
+	std::atomic<double> sampleRate = 44100.0;
+	std::atomic<int> columns = 0;
+	int binsCount = 0; // columns count used to build columnBins
+	double binsSrate = 0.0; // sample rate used to build columnBins
+	std::vector<std::pair<float, float>> columnBins; // fractional fft bin range of each column
+	std::vector<float> workLevels;
+
+	std::mutex levelsmtx;
+	std::vector<float> levels;
+	bool levelsReady = false;
+};
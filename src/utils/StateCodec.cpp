@@ -0,0 +1,208 @@
+#include "StateCodec.h"
+#include <sstream>
+
+void StateCodec::write(const juce::ValueTree& state, juce::MemoryBlock& dest, bool compress)
+{
+	dest.reset();
+	juce::MemoryOutputStream out(dest, false);
+	out.writeInt((int)MAGIC);
+	out.writeByte((char)FORMAT_VERSION);
+	out.writeByte((char)(compress ? FLAG_GZIP : 0));
+
+	if (compress) {
+		juce::GZIPCompressorOutputStream gzip(out, 6);
+		state.writeToStream(gzip);
+	}
+	else {
+		state.writeToStream(out);
+	}
+}
+
+juce::ValueTree StateCodec::read(const void* data, int sizeInBytes)
+{
+	juce::MemoryInputStream in(data, (size_t)sizeInBytes, false);
+	if (sizeInBytes < 6 || (juce::uint32)in.readInt() != MAGIC) {
+		// legacy XML state
+		std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+		return xml ? juce::ValueTree::fromXml(*xml) : juce::ValueTree();
+	}
+
+	auto version = (juce::uint8)in.readByte();
+	auto flags = (juce::uint8)in.readByte();
+	if (version > FORMAT_VERSION)
+		return {};
+
+	if (flags & FLAG_GZIP) {
+		juce::GZIPDecompressorInputStream gzip(in);
+		return juce::ValueTree::readFromStream(gzip);
+	}
+	return juce::ValueTree::readFromStream(in);
+}
+
+juce::MemoryBlock StateCodec::encodePoints(const std::vector<PPoint>& points)
+{
+	juce::MemoryBlock block;
+	block.ensureSize(5 + points.size() * POINT_BYTES);
+	juce::MemoryOutputStream out(block, false);
+	out.writeCompressedInt((int)points.size());
+	for (auto& p : points) {
+		out.writeDouble(p.x);
+		out.writeDouble(p.y);
+		out.writeDouble(p.tension);
+		out.writeInt(p.type);
+	}
+	out.flush();
+	block.setSize(out.getDataSize());
+	return block;
+}
+
+juce::MemoryBlock StateCodec::encodeCells(const std::vector<Cell>& cells)
+{
+	juce::MemoryBlock block;
+	block.ensureSize(5 + cells.size() * CELL_BYTES);
+	juce::MemoryOutputStream out(block, false);
+	out.writeCompressedInt((int)cells.size());
+	for (auto& c : cells) {
+		out.writeByte((char)c.shape);
+		out.writeByte((char)c.lshape);
+		out.writeInt(c.ptool);
+		out.writeBool(c.invertx);
+		out.writeDouble(c.minx);
+		out.writeDouble(c.maxx);
+		out.writeDouble(c.miny);
+		out.writeDouble(c.maxy);
+		out.writeDouble(c.tenatt);
+		out.writeDouble(c.tenrel);
+		out.writeDouble(c.skew);
+	}
+	out.flush();
+	block.setSize(out.getDataSize());
+	return block;
+}
+
+juce::String StateCodec::encodePointsText(const std::vector<PPoint>& points)
+{
+	std::ostringstream oss;
+	for (const auto& point : points) {
+		oss << point.x << " " << point.y << " " << point.tension << " " << point.type << " ";
+	}
+	return oss.str();
+}
+
+juce::String StateCodec::encodeCellsText(const std::vector<Cell>& cells)
+{
+	std::ostringstream oss;
+	for (const auto& cell : cells) {
+		oss << cell.shape << ' '
+			<< cell.lshape << ' '
+			<< cell.ptool << ' '
+			<< cell.invertx << ' '
+			<< cell.minx << ' '
+			<< cell.maxx << ' '
+			<< cell.miny << ' '
+			<< cell.maxy << ' '
+			<< cell.tenatt << ' '
+			<< cell.tenrel << ' '
+			<< cell.skew << '\n';
+	}
+	return oss.str();
+}
+
+// decoded into a local vector, points is left untouched when the value is malformed
+bool StateCodec::decodePoints(const juce::var& value, std::vector<PPoint>& points)
+{
+	std::vector<PPoint> decoded;
+	if (auto* block = value.getBinaryData()) {
+		juce::MemoryInputStream in(*block, false);
+		auto count = in.readCompressedInt();
+		if (count < 0 || (size_t)in.getNumBytesRemaining() < (size_t)count * POINT_BYTES)
+			return false;
+
+		decoded.reserve((size_t)count);
+		for (int i = 0; i < count; ++i) {
+			PPoint p{};
+			p.x = in.readDouble();
+			p.y = in.readDouble();
+			p.tension = in.readDouble();
+			p.type = in.readInt();
+			decoded.push_back(p);
+		}
+		points.swap(decoded);
+		return true;
+	}
+
+	// legacy text format: x y tension type ...
+	auto str = value.toString().toStdString();
+	if (str.empty())
+		return false;
+
+	double x, y, tension;
+	int type;
+	std::istringstream iss(str);
+	while (iss >> x >> y >> tension >> type) {
+		decoded.push_back({ 0, x, y, tension, type });
+	}
+	points.swap(decoded);
+	return true;
+}
+
+// shape bytes and paint tool indexes come from the host chunk, out of range values are rejected
+static bool isValidCell(int shape, int lshape, int ptool)
+{
+	return shape >= SNone && shape <= SSine
+		&& lshape >= SNone && lshape <= SSine
+		&& ptool >= 0 && ptool < PAINT_PATS;
+}
+
+// decoded into a local vector, cells is left untouched when the value is malformed
+bool StateCodec::decodeCells(const juce::var& value, std::vector<Cell>& cells)
+{
+	std::vector<Cell> decoded;
+	if (auto* block = value.getBinaryData()) {
+		juce::MemoryInputStream in(*block, false);
+		auto count = in.readCompressedInt();
+		if (count < 0 || (size_t)in.getNumBytesRemaining() < (size_t)count * CELL_BYTES)
+			return false;
+
+		decoded.reserve((size_t)count);
+		for (int i = 0; i < count; ++i) {
+			int shape = (juce::uint8)in.readByte();
+			int lshape = (juce::uint8)in.readByte();
+			Cell c{};
+			c.ptool = in.readInt();
+			c.invertx = in.readBool();
+			c.minx = in.readDouble();
+			c.maxx = in.readDouble();
+			c.miny = in.readDouble();
+			c.maxy = in.readDouble();
+			c.tenatt = in.readDouble();
+			c.tenrel = in.readDouble();
+			c.skew = in.readDouble();
+			if (!isValidCell(shape, lshape, c.ptool))
+				return false;
+			c.shape = static_cast<CellShape>(shape);
+			c.lshape = static_cast<CellShape>(lshape);
+			decoded.push_back(c);
+		}
+		cells.swap(decoded);
+		return true;
+	}
+
+	// legacy text format, one cell per line
+	auto str = value.toString().toStdString();
+	Cell cell;
+	int shape, lshape;
+	std::istringstream iss(str);
+	while (iss >> shape >> lshape >> cell.ptool >> cell.invertx
+		>> cell.minx >> cell.maxx >> cell.miny >> cell.maxy >> cell.tenatt
+		>> cell.tenrel >> cell.skew)
+	{
+		if (!isValidCell(shape, lshape, cell.ptool))
+			return false;
+		cell.shape = static_cast<CellShape>(shape);
+		cell.lshape = static_cast<CellShape>(lshape);
+		decoded.push_back(cell);
+	}
+	cells.swap(decoded);
+	return true;
+}
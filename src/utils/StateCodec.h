@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../dsp/Pattern.h"
+#include "../ui/Sequencer.h"
+
+/**
+ * Binary plugin state format.
+ *
+ * Layout: magic (4 bytes), format version (1 byte), flags (1 byte), body.
+ * The body is the state ValueTree in JUCE binary form, optionally gzip compressed.
+ * Patterns and sequencer cells are stored as binary properties with a varint
+ * record count followed by fixed width little endian records,
+ * so loading does not go through XML or text parsing.
+ *
+ * States saved by previous versions (XML with text patterns) are still read.
+ */
+class StateCodec
+{
+public:
+	static constexpr juce::uint32 MAGIC = 0x42323147; // "G12B"
+	static constexpr juce::uint8 FORMAT_VERSION = 1;
+	static constexpr juce::uint8 FLAG_GZIP = 1;
+	static constexpr size_t POINT_BYTES = 3 * 8 + 4;
+	static constexpr size_t CELL_BYTES = 1 + 1 + 4 + 1 + 7 * 8;
+
+	/**
+	 * Writes the state in binary format
+	 * @param compress Gzip the body, smaller chunks at the cost of save and load time
+	 */
+	static void write(const juce::ValueTree& state, juce::MemoryBlock& dest, bool compress = false);
+
+	/**
+	 * Reads a binary or legacy XML state, returns an invalid tree on failure
+	 */
+	static juce::ValueTree read(const void* data, int sizeInBytes);
+
+	static juce::MemoryBlock encodePoints(const std::vector<PPoint>& points);
+	static juce::MemoryBlock encodeCells(const std::vector<Cell>& cells);
+
+	/**
+	 * Legacy text encoding, kept to compare both formats in the state benchmark
+	 */
+	static juce::String encodePointsText(const std::vector<PPoint>& points);
+	static juce::String encodeCellsText(const std::vector<Cell>& cells);
+
+	/**
+	 * Decode a pattern or cells property, binary or legacy text
+	 * @return false if the property is missing or malformed, the vector is then left unchanged
+	 */
+	static bool decodePoints(const juce::var& value, std::vector<PPoint>& points);
+	static bool decodeCells(const juce::var& value, std::vector<Cell>& cells);
+};
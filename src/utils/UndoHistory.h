@@ -0,0 +1,213 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include "../Globals.h"
+
+/**
+ * Bytes used by the undo histories of a plugin instance.
+ * Shared by every history of the instance so they all count against the same budget,
+ * when over the limit the oldest undo or redo points of any history are dropped first.
+ */
+struct UndoBudget
+{
+	struct Client
+	{
+		virtual ~Client() = default;
+		virtual uint64_t oldestStamp() const = 0; // max value when the history has nothing to drop
+		virtual void dropOldest() = 0;
+	};
+
+	size_t used = 0;
+	size_t limit = globals::UNDO_BUDGET_BYTES;
+	uint64_t nextStamp = 0; // creation order of undo and redo points across histories
+	std::vector<Client*> clients;
+
+	void add(Client* c) { clients.push_back(c); }
+	void remove(Client* c) { clients.erase(std::remove(clients.begin(), clients.end(), c), clients.end()); }
+
+	// drops the globally oldest points until the histories fit the limit
+	void trim()
+	{
+		while (used > limit) {
+			Client* oldest = nullptr;
+			auto stamp = std::numeric_limits<uint64_t>::max();
+			for (auto* c : clients) {
+				auto s = c->oldestStamp();
+				if (s < stamp) {
+					stamp = s;
+					oldest = c;
+				}
+			}
+			if (oldest == nullptr)
+				return;
+			oldest->dropOldest();
+		}
+	}
+};
+
+/**
+ * Undo and redo history of a vector of records (pattern points or sequencer cells).
+ * Snapshots are split into fixed size chunks, a chunk equal to the same chunk
+ * of the previous snapshot is shared instead of copied so small edits on large
+ * patterns only allocate the chunks that changed.
+ * Push and pop are O(1) on both ends, the oldest entries are dropped when MAX_UNDO
+ * is exceeded, or across all histories of the instance when the byte budget is exceeded.
+ */
+template <typename T>
+class UndoHistory : private UndoBudget::Client
+{
+public:
+	static constexpr size_t CHUNK_SIZE = 64; // records per chunk
+
+	UndoHistory() : budget(std::make_shared<UndoBudget>()) { budget->add(this); }
+	~UndoHistory() override { clear(); budget->remove(this); }
+
+	UndoHistory(const UndoHistory&) = delete;
+	UndoHistory& operator=(const UndoHistory&) = delete;
+
+	/**
+	 * Shares a byte budget with other histories, call before the first push
+	 */
+	void setBudget(std::shared_ptr<UndoBudget> b)
+	{
+		clear();
+		budget->remove(this);
+		budget = b;
+		budget->add(this);
+	}
+
+	/**
+	 * Saves items as the new undo point and clears the redo history
+	 */
+	void push(const std::vector<T>& items)
+	{
+		undoStack.push_back(makeSnapshot(items, undoStack.empty() ? nullptr : &undoStack.back()));
+		redoStack.clear();
+		trim();
+	}
+
+	/**
+	 * Restores the last undo point into items, items are saved for redo
+	 */
+	bool undo(std::vector<T>& items)
+	{
+		if (undoStack.empty())
+			return false;
+		redoStack.push_back(makeSnapshot(items, &undoStack.back()));
+		restore(undoStack.back(), items);
+		undoStack.pop_back();
+		return true;
+	}
+
+	/**
+	 * Restores the last redo point into items, items are saved for undo
+	 */
+	bool redo(std::vector<T>& items)
+	{
+		if (redoStack.empty())
+			return false;
+		undoStack.push_back(makeSnapshot(items, &redoStack.back()));
+		restore(redoStack.back(), items);
+		redoStack.pop_back();
+		return true;
+	}
+
+	void clear()
+	{
+		undoStack.clear();
+		redoStack.clear();
+	}
+
+	bool canUndo() const { return !undoStack.empty(); }
+	bool canRedo() const { return !redoStack.empty(); }
+
+private:
+	using Chunk = std::shared_ptr<const std::vector<T>>;
+
+	struct Snapshot
+	{
+		std::vector<Chunk> chunks;
+		size_t size = 0;
+		uint64_t stamp = 0; // budget creation order, the oldest are dropped first
+	};
+
+	Snapshot makeSnapshot(const std::vector<T>& items, const Snapshot* base)
+	{
+		Snapshot snap;
+		snap.size = items.size();
+		snap.stamp = budget->nextStamp++;
+		snap.chunks.reserve((items.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+		for (size_t start = 0, i = 0; start < items.size(); start += CHUNK_SIZE, ++i) {
+			auto end = std::min(start + CHUNK_SIZE, items.size());
+			if (base != nullptr && i < base->chunks.size()) {
+				auto& prev = *base->chunks[i];
+				if (prev.size() == end - start && std::equal(prev.begin(), prev.end(), items.begin() + start)) {
+					snap.chunks.push_back(base->chunks[i]);
+					continue;
+				}
+			}
+			snap.chunks.push_back(makeChunk(items.begin() + start, items.begin() + end));
+		}
+		return snap;
+	}
+
+	// allocates a chunk counted against the budget until its last reference is released
+	Chunk makeChunk(typename std::vector<T>::const_iterator first, typename std::vector<T>::const_iterator last)
+	{
+		auto bytes = sizeof(std::vector<T>) + sizeof(T) * (size_t)std::distance(first, last);
+		budget->used += bytes;
+		auto b = budget;
+		return Chunk(new std::vector<T>(first, last), [b, bytes](const std::vector<T>* chunk) {
+			b->used -= bytes;
+			delete chunk;
+		});
+	}
+
+	static void restore(const Snapshot& snap, std::vector<T>& items)
+	{
+		items.clear();
+		items.reserve(snap.size);
+		for (auto& chunk : snap.chunks) {
+			items.insert(items.end(), chunk->begin(), chunk->end());
+		}
+	}
+
+	// drops the oldest undo points over MAX_UNDO, then the oldest points of any history over the byte budget
+	void trim()
+	{
+		while (undoStack.size() > (size_t)globals::MAX_UNDO) {
+			undoStack.pop_front();
+		}
+		budget->trim();
+	}
+
+	// the deepest redo point or the oldest undo point, the last undo point of each history is kept
+	uint64_t oldestStamp() const override
+	{
+		auto stamp = std::numeric_limits<uint64_t>::max();
+		if (undoStack.size() > 1)
+			stamp = undoStack.front().stamp;
+		if (!redoStack.empty())
+			stamp = std::min(stamp, redoStack.front().stamp);
+		return stamp;
+	}
+
+	void dropOldest() override
+	{
+		bool redo = !redoStack.empty() && (undoStack.size() <= 1 || redoStack.front().stamp < undoStack.front().stamp);
+		if (redo)
+			redoStack.pop_front();
+		else if (undoStack.size() > 1)
+			undoStack.pop_front();
+	}
+
+	std::shared_ptr<UndoBudget> budget;
+	std::deque<Snapshot> undoStack;
+	std::deque<Snapshot> redoStack;
+};
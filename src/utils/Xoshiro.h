@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * xoshiro256** pseudo random generator.
+ * Small, fast and gives the same sequence on every platform for the same seed,
+ * the 256 bit state is expanded from a single 64 bit seed with splitmix64.
+ */
+class Xoshiro
+{
+public:
+	explicit Xoshiro(uint64_t seed = 0) { setSeed(seed); }
+
+	void setSeed(uint64_t seed)
+	{
+		for (auto& s : state)
+			s = splitmix(seed);
+	}
+
+	uint64_t next()
+	{
+		const uint64_t result = rotl(state[1] * 5, 7) * 9;
+		const uint64_t t = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+		return result;
+	}
+
+	/**
+	 * Uniform double in [0, 1) using the top 53 bits
+	 */
+	double nextDouble()
+	{
+		return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	/**
+	 * True with the given probability, always consumes one value so sequences stay aligned
+	 */
+	bool nextBool(double probability)
+	{
+		return nextDouble() < probability;
+	}
+
+	static uint64_t splitmix(uint64_t& x)
+	{
+		uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t state[4];
+};